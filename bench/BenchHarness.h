@@ -0,0 +1,137 @@
+// bench/BenchHarness.h
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// small in-house microbenchmark harness for DenPaKid_bench
+// a case does its setup, then loops `while (state.keepRunning()) { ... }`, only the loop is timed
+
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const T *volatile sink;
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+class BenchState
+{
+public:
+    BenchState(long long arg, std::size_t iterations)
+        : m_arg(arg), m_iterations(iterations), m_remaining(iterations) {}
+
+    long long arg() const { return m_arg; }
+    std::size_t iterations() const { return m_iterations; }
+
+    bool keepRunning()
+    {
+        if (m_remaining == m_iterations)
+        {
+            m_start = Clock::now();
+        }
+        if (m_remaining == 0)
+        {
+            m_end = Clock::now();
+            return false;
+        }
+        --m_remaining;
+        return true;
+    }
+
+    double elapsedNs() const
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_end - m_start).count());
+    }
+
+    // items per iteration, used for the ns/item column (defaults to arg)
+    void setItemsPerIteration(long long items) { m_items = items; }
+    long long itemsPerIteration() const { return m_items > 0 ? m_items : std::max(1LL, m_arg); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    long long m_arg;
+    std::size_t m_iterations;
+    std::size_t m_remaining;
+    long long m_items = 0;
+    Clock::time_point m_start;
+    Clock::time_point m_end;
+};
+
+class BenchRunner
+{
+public:
+    using BenchFn = std::function<void(BenchState &)>;
+
+    void add(const std::string &name, BenchFn fn, std::vector<long long> args = {1})
+    {
+        m_cases.push_back({name, std::move(fn), std::move(args)});
+    }
+
+    // runs every case whose name contains filter, returns number of cases run
+    int run(const std::string &filter = "")
+    {
+        int count = 0;
+        std::printf("%-48s %10s %14s %12s %12s\n", "benchmark", "arg", "iterations", "ns/iter", "ns/item");
+        for (const Case &c : m_cases)
+        {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+            for (long long arg : c.args)
+            {
+                runOne(c, arg);
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    static constexpr double MIN_TIME_NS = 100e6; // grow iterations until a run takes this long
+
+private:
+    struct Case
+    {
+        std::string name;
+        BenchFn fn;
+        std::vector<long long> args;
+    };
+
+    void runOne(const Case &c, long long arg)
+    {
+        std::size_t iterations = 1;
+        while (true)
+        {
+            BenchState state(arg, iterations);
+            c.fn(state);
+            double ns = state.elapsedNs();
+            if (ns >= MIN_TIME_NS || iterations >= (1u << 30))
+            {
+                double perIter = ns / iterations;
+                std::printf("%-48s %10lld %14zu %12.1f %12.2f\n", c.name.c_str(), arg, iterations,
+                            perIter, perIter / state.itemsPerIteration());
+                std::fflush(stdout);
+                return;
+            }
+            // aim a bit past the target so the next run is usually the last
+            double scale = ns > 0.0 ? MIN_TIME_NS * 1.4 / ns : 10.0;
+            iterations = static_cast<std::size_t>(iterations * std::min(10.0, std::max(2.0, scale)));
+        }
+    }
+
+    std::vector<Case> m_cases;
+};
+
+#endif // BENCHHARNESS_H
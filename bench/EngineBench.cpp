@@ -0,0 +1,252 @@
+// bench/EngineBench.cpp
+#include "BenchHarness.h"
+#include "core/Game.h"
+#include "core/Benchmark.h"
+#include "scene/GameScene.h"
+#include "entities/Player.h"
+#include "physics/PhysicsEngine.h"
+#include "level/PatternScript.h"
+#include "render/ResourceManager.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// reaches into GameScene the same way the --bench driver does
+struct GameSceneBenchAccess
+{
+    static void clearLasers(GameScene &scene) { scene.clearLasers(); }
+    static void updateLasers(GameScene &scene, sf::Time dt)
+    {
+        scene.updateEvents(dt); // fires the despawns
+        scene.updateLasers(dt);
+    }
+    static bool checkLaserCollisions(const GameScene &scene) { return scene.checkLaserCollisions(); }
+    static void updateHUD(GameScene &scene) { scene.updateHUD(); }
+    static void updateFieldVisuals(GameScene &scene)
+    {
+        scene.m_fieldVisualsValid = false; // force the full rebuild
+        scene.updateFieldVisuals();
+    }
+    static std::size_t bFieldSymbolCount(const GameScene &scene) { return scene.m_fieldSymbolCount; }
+
+    // pick B so the symbol grid is symbolsPerRow x symbolsPerRow
+    static void setSymbolGrid(GameScene &scene, int symbolsPerRow)
+    {
+        scene.m_currentFields.magneticField_Z = (symbolsPerRow * symbolsPerRow + 0.5f) / GameScene::B_FIELD_DENSITY_SCALE_FACTOR;
+        scene.m_currentFields.electricField = {40.f, 0.f};
+    }
+
+    static void parkPlayer(GameScene &scene)
+    {
+        // out of the way of every laser so the collision loop never exits early
+        scene.m_player->setPosition({-1000.f, -1000.f});
+    }
+};
+
+namespace
+{
+    const sf::Time FRAME_STEP = sf::seconds(1.f / 60.f);
+
+    GameScene &playingScene(Game &game)
+    {
+        if (game.getCurrentState() != GameState::Playing)
+        {
+            game.changeScene(GameState::Playing);
+        }
+        GameScene *scene = dynamic_cast<GameScene *>(game.getCurrentScene());
+        if (!scene)
+        {
+            throw std::runtime_error("DenPaKid_bench: GameScene not available");
+        }
+        return *scene;
+    }
+
+    void registerBenchmarks(BenchRunner &runner, Game &game, sf::Texture &playerTexture)
+    {
+        // the player texture on its own, the whole of it is the region
+        sf::IntRect playerRegion(0, 0, static_cast<int>(playerTexture.getSize().x), static_cast<int>(playerTexture.getSize().y));
+        runner.add("PhysicsEngine::updatePlayer", [&, playerRegion](BenchState &state)
+                   {
+                       std::vector<Player> players;
+                       players.reserve(state.arg());
+                       for (long long i = 0; i < state.arg(); ++i)
+                       {
+                           players.emplace_back(sf::Vector2f(200.f + i % 800, 100.f + i % 500), playerTexture, playerRegion);
+                           players.back().setVelocity({100.f, 0.f});
+                       }
+                       PhysicsEngine physics;
+                       FieldProperties fields;
+                       fields.electricField = {20.f, 0.f};
+                       fields.magneticField_Z = 1.5f;
+                       sf::Vector2u windowSize = game.getWindow().getSize();
+                       sf::FloatRect bounds(0.f, 0.f, static_cast<float>(windowSize.x), static_cast<float>(windowSize.y));
+                       while (state.keepRunning())
+                       {
+                           for (auto &player : players)
+                           {
+                               physics.updatePlayer(player, FRAME_STEP, fields, bounds);
+                           }
+                           doNotOptimize(players.front().getPosition());
+                       } },
+                   {1, 16, 256, 4096});
+
+        runner.add("GameScene::updateLasers (integrate+despawn)", [&](BenchState &state)
+                   {
+                       GameScene &scene = playingScene(game);
+                       GameSceneBenchAccess::clearLasers(scene);
+                       Benchmark::topUpLasers(scene, static_cast<std::size_t>(state.arg()));
+                       while (state.keepRunning())
+                       {
+                           GameSceneBenchAccess::updateLasers(scene, FRAME_STEP);
+                           // replace the ones that left the screen
+                           Benchmark::topUpLasers(scene, static_cast<std::size_t>(state.arg()));
+                       } },
+                   {100, 1000, 10000});
+
+        runner.add("PatternScript::run (resume every instance)", [&](BenchState &state)
+                   {
+                       // a spiral that fires and waits every resume, restarted when it ends
+                       const char *source = "pattern spiral\n"
+                                            "    let start = rand * 40\n"
+                                            "    repeat 16\n"
+                                            "        shoot 1, 0, 100 + start + i * 11, 230\n"
+                                            "        wait 0.08\n"
+                                            "    end\n"
+                                            "end\n";
+                       PatternProgram program;
+                       std::string error;
+                       if (!PatternScript::compile(source, program, error))
+                       {
+                           throw std::runtime_error("DenPaKid_bench: " + error);
+                       }
+                       std::vector<PatternState> instances(static_cast<std::size_t>(state.arg()));
+                       for (std::size_t i = 0; i < instances.size(); ++i)
+                       {
+                           PatternScript::start(program, 0, static_cast<std::uint32_t>(i + 1), instances[i]);
+                       }
+                       PatternEnv env;
+                       float sum = 0.f;
+                       while (state.keepRunning())
+                       {
+                           for (std::size_t i = 0; i < instances.size(); ++i)
+                           {
+                               if (PatternScript::run(program, instances[i], env, [&](const PatternShot &shot)
+                                                      { sum += shot.angle; }) < 0.f)
+                               {
+                                   PatternScript::start(program, 0, static_cast<std::uint32_t>(i + 1), instances[i]);
+                               }
+                           }
+                       }
+                       doNotOptimize(sum);
+                       state.setItemsPerIteration(state.arg()); },
+                   {100, 1000, 10000});
+
+        runner.add("GameScene player-vs-laser collision", [&](BenchState &state)
+                   {
+                       GameScene &scene = playingScene(game);
+                       GameSceneBenchAccess::clearLasers(scene);
+                       Benchmark::topUpLasers(scene, static_cast<std::size_t>(state.arg()));
+                       GameSceneBenchAccess::parkPlayer(scene);
+                       while (state.keepRunning())
+                       {
+                           doNotOptimize(GameSceneBenchAccess::checkLaserCollisions(scene));
+                       } },
+                   {100, 1000, 10000});
+
+        runner.add("GameScene::updateFieldVisuals", [&](BenchState &state)
+                   {
+                       GameScene &scene = playingScene(game);
+                       GameSceneBenchAccess::setSymbolGrid(scene, static_cast<int>(state.arg()));
+                       while (state.keepRunning())
+                       {
+                           GameSceneBenchAccess::updateFieldVisuals(scene);
+                       }
+                       state.setItemsPerIteration(static_cast<long long>(GameSceneBenchAccess::bFieldSymbolCount(scene))); },
+                   {1, 4, 8, 15});
+
+        runner.add("GameScene::updateHUD", [&](BenchState &state)
+                   {
+                       GameScene &scene = playingScene(game);
+                       while (state.keepRunning())
+                       {
+                           game.getFrameArena().reset(); // as at the top of a real frame
+                           for (long long i = 0; i < state.arg(); ++i)
+                           {
+                               GameSceneBenchAccess::updateHUD(scene);
+                           }
+                       } },
+                   {1, 16});
+
+        runner.add("ResourceManager lookups", [&](BenchState &state)
+                   {
+                       ResourceManager &resources = ResourceManager::getInstance();
+                       // all already cached by GameScene::loadAssets
+                       const char *ids[] = {"player", "game_bg", "scroll_item", "laser_beam"};
+                       const char *paths[] = {"../../assets/images/player_sprite.png", "../../assets/images/game_bg.png",
+                                              "../../assets/images/scroll_item.png", "../../assets/images/laser.png"};
+                       while (state.keepRunning())
+                       {
+                           for (long long i = 0; i < state.arg(); ++i)
+                           {
+                               doNotOptimize(resources.loadTexture(ids[i % 4], paths[i % 4]).getSize());
+                           }
+                           doNotOptimize(resources.getDefaultFont().getInfo());
+                       } },
+                   {1, 16, 256});
+
+        runner.add("Player charge operations", [&, playerRegion](BenchState &state)
+                   {
+                       std::vector<Player> players;
+                       players.reserve(state.arg());
+                       for (long long i = 0; i < state.arg(); ++i)
+                       {
+                           players.emplace_back(sf::Vector2f(100.f, 100.f), playerTexture, playerRegion);
+                       }
+                       while (state.keepRunning())
+                       {
+                           for (auto &player : players)
+                           {
+                               player.increaseCharge();
+                               player.toggleChargeSign();
+                               player.decreaseCharge();
+                               player.setCharge(player.getCharge() * 1.5f);
+                           }
+                           doNotOptimize(players.front().getCharge());
+                       } },
+                   {1, 16, 256, 4096});
+    }
+}
+
+// DenPaKid_bench [filter]
+int main(int argc, char *argv[])
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    try
+    {
+        Game game(1280, 720, "DenPaKid_bench");
+        game.getWindow().setVerticalSyncEnabled(false);
+        playingScene(game);
+        sf::Texture &playerTexture = ResourceManager::getInstance().loadTexture("player", "../../assets/images/player_sprite.png");
+
+        BenchRunner runner;
+        registerBenchmarks(runner, game, playerTexture);
+
+        // game code logs on every charge change and spawn, keep that out of the numbers
+        std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+        int ran = runner.run(filter);
+        std::cout.rdbuf(coutBuffer);
+        std::cout.clear();
+
+        if (ran == 0)
+        {
+            std::cerr << "No benchmark matches filter: " << filter << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "An exception occurred: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+// src/audio/AudioMixer.cpp
+#include "AudioMixer.h"
+#include <algorithm>
+#include <cmath>
+
+AudioMixer::AudioMixer()
+    : m_mixBuffer(CHUNK_FRAMES * CHANNELS),
+      m_outputBuffer(CHUNK_FRAMES * CHANNELS)
+{
+    initialize(CHANNELS, SAMPLE_RATE);
+    setProcessingInterval(sf::milliseconds(5)); // default 10 ms adds noticeable delay to short effects
+}
+
+AudioMixer::~AudioMixer()
+{
+    // the streaming thread calls onGetData, stop it before our members go away
+    stop();
+}
+
+AudioMixer::VoiceHandle AudioMixer::playSound(const sf::SoundBuffer &buffer, const VoiceParams &params)
+{
+    if (buffer.getSampleCount() == 0 || buffer.getChannelCount() == 0)
+    {
+        return 0;
+    }
+    Command command;
+    command.type = CommandType::Play;
+    command.handle = m_nextHandle++;
+    if (m_nextHandle == 0)
+    {
+        m_nextHandle = 1;
+    }
+    command.samples = buffer.getSamples();
+    command.channels = buffer.getChannelCount();
+    command.frameCount = buffer.getSampleCount() / command.channels;
+    command.sampleRate = buffer.getSampleRate();
+    command.params = params;
+    if (!m_commands.push(command))
+    {
+        m_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    return command.handle;
+}
+
+void AudioMixer::stopSound(VoiceHandle handle)
+{
+    if (handle == 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::Stop;
+    command.handle = handle;
+    if (!m_commands.push(command))
+    {
+        m_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioMixer::stopAllSounds()
+{
+    Command command;
+    command.type = CommandType::StopAll;
+    if (!m_commands.push(command))
+    {
+        m_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioMixer::setVoiceLimit(std::size_t voices)
+{
+    m_voiceLimit.store(std::max<std::size_t>(1, std::min(voices, MAX_VOICES)), std::memory_order_relaxed);
+}
+
+bool AudioMixer::onGetData(Chunk &data)
+{
+    applyCommands();
+
+    std::fill(m_mixBuffer.begin(), m_mixBuffer.end(), 0.f);
+    unsigned int active = 0;
+    std::size_t limit = m_voiceLimit.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < MAX_VOICES; ++i)
+    {
+        Voice &voice = m_voices[i];
+        if (i >= limit)
+        {
+            voice.active = false;
+        }
+        else if (voice.active)
+        {
+            mixVoice(voice, m_mixBuffer.data(), CHUNK_FRAMES);
+            active += voice.active ? 1 : 0;
+        }
+    }
+    m_activeVoices.store(active, std::memory_order_relaxed);
+
+    // hard clip, effects are short and rarely stack high enough for a limiter to matter
+    float master = m_masterGain.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < m_mixBuffer.size(); ++i)
+    {
+        float sample = std::max(-1.f, std::min(1.f, m_mixBuffer[i] * master));
+        m_outputBuffer[i] = static_cast<sf::Int16>(sample * 32767.f);
+    }
+
+    // never end the stream, silence is cheaper than restarting the source
+    data.samples = m_outputBuffer.data();
+    data.sampleCount = m_outputBuffer.size();
+    return true;
+}
+
+void AudioMixer::onSeek(sf::Time)
+{
+    // nothing to seek, the mixer is a live stream
+}
+
+void AudioMixer::applyCommands()
+{
+    Command command;
+    while (m_commands.pop(command))
+    {
+        switch (command.type)
+        {
+        case CommandType::Play:
+            startVoice(command);
+            break;
+        case CommandType::Stop:
+            for (Voice &voice : m_voices)
+            {
+                if (voice.active && voice.handle == command.handle)
+                {
+                    voice.active = false;
+                }
+            }
+            break;
+        case CommandType::StopAll:
+            for (Voice &voice : m_voices)
+            {
+                voice.active = false;
+            }
+            break;
+        }
+    }
+}
+
+void AudioMixer::startVoice(const Command &command)
+{
+    Voice *voice = findVoiceFor(command.params.priority);
+    if (!voice)
+    {
+        return; // everything playing matters more
+    }
+
+    // equal-power pan so a centred voice isn't louder than a hard-panned one
+    float pan = std::max(-1.f, std::min(1.f, command.params.pan));
+    float angle = (pan + 1.f) * 0.25f * 3.14159265f;
+    float gain = std::max(0.f, command.params.gain);
+
+    voice->active = true;
+    voice->handle = command.handle;
+    voice->samples = command.samples;
+    voice->frameCount = command.frameCount;
+    voice->channels = command.channels;
+    voice->position = 0.0;
+    voice->step = static_cast<double>(command.sampleRate) / SAMPLE_RATE;
+    voice->gainLeft = gain * std::cos(angle);
+    voice->gainRight = gain * std::sin(angle);
+    voice->priority = command.params.priority;
+}
+
+AudioMixer::Voice *AudioMixer::findVoiceFor(int priority)
+{
+    Voice *victim = nullptr;
+    std::size_t limit = m_voiceLimit.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < limit; ++i)
+    {
+        Voice &voice = m_voices[i];
+        if (!voice.active)
+        {
+            return &voice;
+        }
+        // lowest priority first, then whichever is closest to finishing anyway
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority &&
+             voice.position / voice.frameCount > victim->position / victim->frameCount))
+        {
+            victim = &voice;
+        }
+    }
+    if (victim->priority > priority)
+    {
+        return nullptr;
+    }
+    m_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+    return victim;
+}
+
+void AudioMixer::mixVoice(Voice &voice, float *out, std::size_t frames)
+{
+    const float scale = 1.f / 32768.f;
+    for (std::size_t i = 0; i < frames; ++i)
+    {
+        std::uint64_t frame = static_cast<std::uint64_t>(voice.position);
+        if (frame + 1 >= voice.frameCount)
+        {
+            voice.active = false;
+            return;
+        }
+        // linear interpolation covers buffers that aren't at the mixer rate
+        float t = static_cast<float>(voice.position - static_cast<double>(frame));
+        const sf::Int16 *a = voice.samples + frame * voice.channels;
+        const sf::Int16 *b = a + voice.channels;
+        float left = (a[0] + (b[0] - a[0]) * t) * scale;
+        float right = left;
+        if (voice.channels > 1)
+        {
+            right = (a[1] + (b[1] - a[1]) * t) * scale;
+        }
+        out[i * 2] += left * voice.gainLeft;
+        out[i * 2 + 1] += right * voice.gainRight;
+        voice.position += voice.step;
+    }
+}
@@ -0,0 +1,108 @@
+// src/audio/AudioMixer.h
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../core/SpscQueue.h"
+
+struct VoiceParams
+{
+    float gain = 1.f;  // 0..1, on top of the mixer's master gain
+    float pan = 0.f;   // -1 left .. 1 right
+    int priority = 0;  // a full mixer steals the lowest-priority voice if it isn't above this
+};
+
+// mixes short sound effects into a single stereo stream, so any number of overlapping
+// effects costs one OpenAL source instead of one sf::Sound each
+// the game thread only talks to it through a lock-free command queue, mixing runs on SFML's streaming thread
+class AudioMixer : public sf::SoundStream
+{
+public:
+    using VoiceHandle = std::uint32_t; // 0 = not playing
+
+    AudioMixer();
+    ~AudioMixer() override;
+
+    AudioMixer(const AudioMixer &) = delete;
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    // game thread. buffer must stay alive while it can be playing (ResourceManager buffers live for the session)
+    VoiceHandle playSound(const sf::SoundBuffer &buffer, const VoiceParams &params = {});
+    void stopSound(VoiceHandle handle);
+    void stopAllSounds();
+    void setMasterGain(float gain) { m_masterGain.store(gain, std::memory_order_relaxed); } // 0..1
+    // voices the mixer may use, 1..MAX_VOICES. lowering it cuts off whatever plays above the limit
+    void setVoiceLimit(std::size_t voices);
+    std::size_t getVoiceLimit() const { return m_voiceLimit.load(std::memory_order_relaxed); }
+
+    // stats, read from the game thread
+    unsigned int getActiveVoiceCount() const { return m_activeVoices.load(std::memory_order_relaxed); }
+    unsigned int getStolenVoiceCount() const { return m_stolenVoices.load(std::memory_order_relaxed); }
+    unsigned int getDroppedCommandCount() const { return m_droppedCommands.load(std::memory_order_relaxed); }
+
+    static constexpr unsigned int SAMPLE_RATE = 44100;
+    static constexpr unsigned int CHANNELS = 2;
+    static constexpr std::size_t MAX_VOICES = 32;
+    static constexpr std::size_t CHUNK_FRAMES = 512; // ~12 ms per chunk
+
+protected:
+    bool onGetData(Chunk &data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    enum class CommandType
+    {
+        Play,
+        Stop,
+        StopAll
+    };
+
+    struct Command
+    {
+        CommandType type = CommandType::Play;
+        VoiceHandle handle = 0;
+        const sf::Int16 *samples = nullptr;
+        std::uint64_t frameCount = 0;
+        unsigned int channels = 1;
+        unsigned int sampleRate = SAMPLE_RATE;
+        VoiceParams params;
+    };
+
+    struct Voice
+    {
+        bool active = false;
+        VoiceHandle handle = 0;
+        const sf::Int16 *samples = nullptr;
+        std::uint64_t frameCount = 0;
+        unsigned int channels = 1;
+        double position = 0.0; // in source frames
+        double step = 1.0;     // source frames per output frame
+        float gainLeft = 0.f;
+        float gainRight = 0.f;
+        int priority = 0;
+    };
+
+    // audio thread
+    void applyCommands();
+    void startVoice(const Command &command);
+    Voice *findVoiceFor(int priority);
+    void mixVoice(Voice &voice, float *out, std::size_t frames);
+
+    SpscQueue<Command, 256> m_commands;
+    VoiceHandle m_nextHandle = 1; // game thread only
+    std::array<Voice, MAX_VOICES> m_voices;
+    std::vector<float> m_mixBuffer;
+    std::vector<sf::Int16> m_outputBuffer;
+
+    std::atomic<float> m_masterGain{1.f};
+    std::atomic<std::size_t> m_voiceLimit{MAX_VOICES};
+    std::atomic<unsigned int> m_activeVoices{0};
+    std::atomic<unsigned int> m_stolenVoices{0};
+    std::atomic<unsigned int> m_droppedCommands{0};
+};
+
+#endif // AUDIOMIXER_H
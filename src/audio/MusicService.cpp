@@ -0,0 +1,176 @@
+// src/audio/MusicService.cpp
+#include "MusicService.h"
+#include <algorithm>
+#include <iostream>
+
+MusicService::MusicService()
+    : m_decodeBuffer(CHUNK_FRAMES * CHANNELS),
+      m_mixBuffer(CHUNK_FRAMES * CHANNELS),
+      m_outputBuffer(CHUNK_FRAMES * CHANNELS)
+{
+    initialize(CHANNELS, SAMPLE_RATE);
+}
+
+MusicService::~MusicService()
+{
+    // the streaming thread calls onGetData, stop it before our members go away
+    stop();
+}
+
+bool MusicService::openTrack(MusicTrack track, const std::string &filepath, float volumeScale)
+{
+    // tracks belong to the streaming thread once it runs
+    stop();
+
+    Track &slot = m_tracks[static_cast<std::size_t>(track)];
+    slot.open = false;
+    if (!slot.file.openFromFile(filepath))
+    {
+        std::cerr << "MusicService: failed to open " << filepath << std::endl;
+        return false;
+    }
+    // no resampling, a track at another rate would play at the wrong pitch
+    if (slot.file.getSampleRate() != SAMPLE_RATE || slot.file.getChannelCount() == 0 || slot.file.getChannelCount() > CHANNELS)
+    {
+        std::cerr << "MusicService: " << filepath << " must be mono or stereo at " << SAMPLE_RATE << " Hz" << std::endl;
+        return false;
+    }
+    slot.open = true;
+    slot.channels = slot.file.getChannelCount();
+    slot.volumeScale = volumeScale;
+    slot.gain = 0.f;
+    slot.target = 0.f;
+    return true;
+}
+
+void MusicService::crossfadeTo(MusicTrack track, sf::Time fadeTime, bool restart)
+{
+    Command command;
+    command.track = static_cast<int>(track);
+    command.fadeSeconds = fadeTime.asSeconds();
+    command.restart = restart;
+    m_commands.push(command); // a full queue only happens with nobody streaming, dropping is fine
+}
+
+void MusicService::fadeOut(sf::Time fadeTime)
+{
+    Command command;
+    command.fadeSeconds = fadeTime.asSeconds();
+    m_commands.push(command);
+}
+
+bool MusicService::onGetData(Chunk &data)
+{
+    applyCommands();
+
+    std::fill(m_mixBuffer.begin(), m_mixBuffer.end(), 0.f);
+    for (Track &track : m_tracks)
+    {
+        // a silent track isn't decoded, it picks up where it left off when faded back in
+        if (track.open && (track.gain > 0.f || track.target > 0.f))
+        {
+            mixTrack(track, m_mixBuffer.data(), CHUNK_FRAMES);
+        }
+    }
+
+    // volume button steps would click if applied at a chunk boundary
+    float master = m_masterGain.load(std::memory_order_relaxed);
+    float masterStep = (master - m_appliedMasterGain) / CHUNK_FRAMES;
+    for (std::size_t frame = 0; frame < CHUNK_FRAMES; ++frame)
+    {
+        m_appliedMasterGain += masterStep;
+        for (unsigned int c = 0; c < CHANNELS; ++c)
+        {
+            float sample = std::max(-1.f, std::min(1.f, m_mixBuffer[frame * CHANNELS + c] * m_appliedMasterGain));
+            m_outputBuffer[frame * CHANNELS + c] = static_cast<sf::Int16>(sample * 32767.f);
+        }
+    }
+    m_appliedMasterGain = master;
+
+    data.samples = m_outputBuffer.data();
+    data.sampleCount = m_outputBuffer.size();
+    return true;
+}
+
+void MusicService::onSeek(sf::Time)
+{
+    // each track keeps its own position, the stream as a whole has nothing to seek
+}
+
+void MusicService::applyCommands()
+{
+    Command command;
+    while (m_commands.pop(command))
+    {
+        for (std::size_t i = 0; i < m_tracks.size(); ++i)
+        {
+            Track &track = m_tracks[i];
+            if (!track.open)
+            {
+                continue;
+            }
+            bool selected = static_cast<int>(i) == command.track;
+            if (selected && command.restart)
+            {
+                track.file.seek(sf::Uint64(0));
+            }
+            track.target = selected ? 1.f : 0.f;
+            if (command.fadeSeconds <= 0.f)
+            {
+                track.gain = track.target;
+                track.step = 0.f;
+            }
+            else
+            {
+                track.step = 1.f / (command.fadeSeconds * SAMPLE_RATE);
+            }
+        }
+    }
+}
+
+void MusicService::mixTrack(Track &track, float *out, std::size_t frames)
+{
+    std::size_t decoded = readLooped(track, m_decodeBuffer.data(), frames);
+    const float scale = track.volumeScale / 32768.f;
+    for (std::size_t frame = 0; frame < decoded; ++frame)
+    {
+        // ramp per sample frame so crossfades are smooth regardless of chunk size
+        if (track.gain < track.target)
+        {
+            track.gain = std::min(track.target, track.gain + track.step);
+        }
+        else if (track.gain > track.target)
+        {
+            track.gain = std::max(track.target, track.gain - track.step);
+        }
+        const sf::Int16 *in = &m_decodeBuffer[frame * track.channels];
+        float left = in[0] * scale * track.gain;
+        float right = track.channels > 1 ? in[1] * scale * track.gain : left;
+        out[frame * CHANNELS] += left;
+        out[frame * CHANNELS + 1] += right;
+    }
+}
+
+std::size_t MusicService::readLooped(Track &track, sf::Int16 *out, std::size_t frames)
+{
+    std::size_t wanted = frames * track.channels;
+    std::size_t got = 0;
+    bool rewound = false;
+    while (got < wanted)
+    {
+        std::size_t read = static_cast<std::size_t>(track.file.read(out + got, wanted - got));
+        if (read == 0)
+        {
+            if (rewound)
+            {
+                break; // empty file
+            }
+            track.file.seek(sf::Uint64(0));
+            rewound = true;
+            continue;
+        }
+        got += read;
+        rewound = false;
+    }
+    return got / track.channels;
+}
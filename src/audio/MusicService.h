@@ -0,0 +1,83 @@
+// src/audio/MusicService.h
+#ifndef MUSICSERVICE_H
+#define MUSICSERVICE_H
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "../core/SpscQueue.h"
+
+enum class MusicTrack
+{
+    Menu,
+    Game,
+    Count
+};
+
+// background music for the whole session, owned by Game
+// every track stays open and is decoded on SFML's streaming thread only while audible,
+// so switching scenes is a gain ramp, never a reopen. a silent track keeps its position (= paused)
+class MusicService : public sf::SoundStream
+{
+public:
+    MusicService();
+    ~MusicService() override;
+
+    MusicService(const MusicService &) = delete;
+    MusicService &operator=(const MusicService &) = delete;
+
+    // before play(). volumeScale is the track's level relative to the master volume
+    bool openTrack(MusicTrack track, const std::string &filepath, float volumeScale = 1.f);
+
+    // game thread, applied at the next mixed chunk with per-sample ramps
+    void crossfadeTo(MusicTrack track, sf::Time fadeTime, bool restart = false); // every other track fades out
+    void fadeOut(sf::Time fadeTime);
+    void setMasterGain(float gain) { m_masterGain.store(gain, std::memory_order_relaxed); } // 0..1
+
+    static constexpr unsigned int SAMPLE_RATE = 44100;
+    static constexpr unsigned int CHANNELS = 2;
+    static constexpr std::size_t CHUNK_FRAMES = 1024; // ~23 ms per chunk
+
+protected:
+    bool onGetData(Chunk &data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    static constexpr std::size_t TRACK_COUNT = static_cast<std::size_t>(MusicTrack::Count);
+
+    struct Command
+    {
+        int track = -1; // -1 = fade everything out
+        float fadeSeconds = 0.f;
+        bool restart = false;
+    };
+
+    struct Track
+    {
+        bool open = false;
+        sf::InputSoundFile file;
+        unsigned int channels = 0;
+        float volumeScale = 1.f;
+        float gain = 0.f; // current fade level, 0..1
+        float target = 0.f;
+        float step = 0.f; // gain change per output frame
+    };
+
+    // audio thread
+    void applyCommands();
+    void mixTrack(Track &track, float *out, std::size_t frames);
+    std::size_t readLooped(Track &track, sf::Int16 *out, std::size_t frames);
+
+    SpscQueue<Command, 64> m_commands;
+    std::array<Track, TRACK_COUNT> m_tracks;
+    std::vector<sf::Int16> m_decodeBuffer;
+    std::vector<float> m_mixBuffer;
+    std::vector<sf::Int16> m_outputBuffer;
+
+    std::atomic<float> m_masterGain{1.f};
+    float m_appliedMasterGain = 1.f; // audio thread, ramped towards m_masterGain over one chunk
+};
+
+#endif // MUSICSERVICE_H
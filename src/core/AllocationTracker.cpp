@@ -0,0 +1,65 @@
+// src/core/AllocationTracker.cpp
+#include "AllocationTracker.h"
+#include "Profiler.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // audio threads allocate too
+    std::atomic<bool> g_enabled{false};
+    std::atomic<std::size_t> g_allocations{0};
+    std::atomic<std::size_t> g_bytes{0};
+}
+
+void AllocationTracker::setEnabled(bool enabled)
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+std::size_t AllocationTracker::allocations()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t AllocationTracker::bytes()
+{
+    return g_bytes.load(std::memory_order_relaxed);
+}
+
+// array and nothrow forms forward here in libstdc++, so only the scalar form is replaced
+void *operator new(std::size_t size)
+{
+    if (g_enabled.load(std::memory_order_relaxed))
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        Profiler::recordAllocation(size);
+    }
+    if (size == 0)
+    {
+        size = 1;
+    }
+    void *ptr = std::malloc(size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,19 @@
+// src/core/AllocationTracker.h
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+// opt-in hook on global operator new/delete (--track-allocs, always on in --bench)
+// main thread allocations are attributed to the active Profiler scope
+namespace AllocationTracker
+{
+    void setEnabled(bool enabled);
+    bool isEnabled();
+
+    // totals over all threads since tracking was enabled
+    std::size_t allocations();
+    std::size_t bytes();
+}
+
+#endif // ALLOCATIONTRACKER_H
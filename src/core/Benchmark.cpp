@@ -0,0 +1,418 @@
+// src/core/Benchmark.cpp
+#include "Benchmark.h"
+#include "Game.h"
+#include "AllocationTracker.h"
+#include "Profiler.h"
+#include "../scene/GameScene.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    const unsigned int BENCH_SEED = 1337;
+    const float BENCH_TIME_STEP = 1.f / 60.f;
+}
+
+Benchmark::Benchmark(Game &game, const BenchmarkOptions &options)
+    : m_game(game), m_options(options)
+{
+}
+
+bool Benchmark::parseScenario(const std::string &name, BenchmarkScenario &scenario)
+{
+    if (name == "steady")
+        scenario = BenchmarkScenario::Steady;
+    else if (name == "lasers")
+        scenario = BenchmarkScenario::Lasers;
+    else if (name == "bfield")
+        scenario = BenchmarkScenario::BFieldDensity;
+    else if (name == "fields")
+        scenario = BenchmarkScenario::FieldChurn;
+    else if (name == "switch")
+        scenario = BenchmarkScenario::SceneSwitch;
+    else if (name == "particles")
+        scenario = BenchmarkScenario::Particles;
+    else
+        return false;
+    return true;
+}
+
+const char *Benchmark::scenarioName(BenchmarkScenario scenario)
+{
+    switch (scenario)
+    {
+    case BenchmarkScenario::Steady:
+        return "steady";
+    case BenchmarkScenario::Lasers:
+        return "lasers";
+    case BenchmarkScenario::BFieldDensity:
+        return "bfield";
+    case BenchmarkScenario::FieldChurn:
+        return "fields";
+    case BenchmarkScenario::SceneSwitch:
+        return "switch";
+    case BenchmarkScenario::Particles:
+        return "particles";
+    }
+    return "unknown";
+}
+
+bool Benchmark::run()
+{
+    std::vector<BenchmarkScenario> scenarios;
+    if (m_options.scenario == "all")
+    {
+        scenarios = {BenchmarkScenario::Steady, BenchmarkScenario::Lasers, BenchmarkScenario::BFieldDensity,
+                     BenchmarkScenario::FieldChurn, BenchmarkScenario::SceneSwitch, BenchmarkScenario::Particles};
+    }
+    else
+    {
+        BenchmarkScenario scenario;
+        if (!parseScenario(m_options.scenario, scenario))
+        {
+            std::cerr << "Unknown benchmark scene: " << m_options.scenario
+                       << " (expected steady, lasers, bfield, fields, switch, particles or all)" << std::endl;
+            return false;
+        }
+        scenarios.push_back(scenario);
+    }
+
+    // measure the work, not the vsync wait
+    m_game.getWindow().setVerticalSyncEnabled(false);
+    m_game.getFrameScheduler().setPauseWhenUnfocused(false); // keep measuring in the background
+    AllocationTracker::setEnabled(true);
+
+    bool allocationFree = true;
+    std::vector<BenchmarkResult> results;
+    for (BenchmarkScenario scenario : scenarios)
+    {
+        if (!m_game.getWindow().isOpen())
+        {
+            break;
+        }
+        results.push_back(runScenario(scenario));
+        if (m_options.failOnAllocation && results.back().totalAllocations > 0)
+        {
+            reportAllocations(results.back());
+            allocationFree = false;
+        }
+    }
+
+    std::string json = toJson(results);
+    std::string path = m_options.outputPath.empty() ? "bench_" + m_options.scenario + ".json" : m_options.outputPath;
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Failed to write benchmark report: " << path << std::endl;
+        std::cout << json << std::endl;
+        return false;
+    }
+    out << json;
+    std::cout << "Benchmark report written to " << path << std::endl;
+    return allocationFree;
+}
+
+void Benchmark::reportAllocations(const BenchmarkResult &result)
+{
+    std::cerr << "FAIL: scene " << result.scenario << " allocated " << result.totalAllocations
+              << " times over " << result.frames << " steady-state frames" << std::endl;
+    for (const auto &scope : result.allocationScopes)
+    {
+        std::cerr << "  " << scope.scope << ": " << scope.allocationsPerFrame << " allocs/frame, "
+                  << scope.bytesPerFrame << " bytes/frame" << std::endl;
+    }
+}
+
+BenchmarkResult Benchmark::runScenario(BenchmarkScenario scenario)
+{
+    std::cout << "Running benchmark scene: " << scenarioName(scenario) << std::endl;
+    prepareScenario(scenario);
+
+    const sf::Time step = sf::seconds(BENCH_TIME_STEP);
+    Profiler &profiler = Profiler::getInstance();
+    std::vector<double> frameMs;
+    frameMs.reserve(m_options.frames); // no allocations inside the measured loop
+    std::vector<BenchmarkScopeAllocations> scopeTotals(Profiler::MAX_SCOPES);
+    std::vector<BenchmarkRenderLayer> layerTotals(RenderStats::MAX_LAYERS);
+    const RenderStats &renderStats = m_game.getRenderStats();
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+    FrameArena &arena = m_game.getFrameArena();
+    std::size_t overflowStart = arena.getOverflowCount();
+    LatencyTracker &latency = m_game.getLatencyTracker();
+
+    for (int frame = -m_options.warmupFrames; frame < m_options.frames && m_game.getWindow().isOpen(); ++frame)
+    {
+        sf::Clock frameClock;
+        arena.reset();
+        profiler.beginFrame();
+        {
+            PROFILE_SCOPE("bench.script");
+            stepScenario(scenario, frame);
+        }
+        if (frame == 0)
+        {
+            latency.reset(); // warmup inputs don't count
+        }
+        latency.onInput(LatencyTracker::Clock::now());
+        m_game.processEvents();
+        m_game.update(step);
+        m_game.render();
+        profiler.endFrame();
+        if (frame < 0)
+        {
+            continue;
+        }
+        frameMs.push_back(frameClock.getElapsedTime().asMicroseconds() / 1000.0);
+
+        // scope slots are stable across frames, so index i is the same scope every time
+        allocations += profiler.getFrameAllocations();
+        bytes += profiler.getFrameBytes();
+        for (std::size_t i = 0; i < profiler.getScopeCount(); ++i)
+        {
+            const ProfileScopeStats &stats = profiler.getScope(i);
+            scopeTotals[i].scope = stats.name;
+            scopeTotals[i].allocationsPerFrame += stats.allocations;
+            scopeTotals[i].bytesPerFrame += stats.bytes;
+        }
+        // layer slots are stable too
+        for (std::size_t i = 0; i < renderStats.getLayerCount(); ++i)
+        {
+            const RenderLayerStats &layer = renderStats.getLayer(i);
+            layerTotals[i].layer = layer.name;
+            layerTotals[i].drawsPerFrame += layer.draws;
+            layerTotals[i].verticesPerFrame += layer.vertices;
+            layerTotals[i].textureSwitchesPerFrame += layer.textureSwitches;
+            layerTotals[i].blendChangesPerFrame += layer.blendChanges;
+        }
+    }
+
+    BenchmarkResult result;
+    result.scenario = scenarioName(scenario);
+    result.frames = static_cast<int>(frameMs.size());
+    if (frameMs.empty())
+    {
+        return result;
+    }
+    result.totalAllocations = allocations;
+    result.arenaHighWaterBytes = arena.getHighWaterMark();
+    result.arenaOverflows = arena.getOverflowCount() - overflowStart;
+    result.latencySamples = latency.getSampleCount();
+    result.latencyP50Ms = latency.getPercentileMs(50.0);
+    result.latencyP95Ms = latency.getPercentileMs(95.0);
+    result.latencyP99Ms = latency.getPercentileMs(99.0);
+    result.latencyMaxMs = latency.getMaxMs();
+    result.allocationsPerFrame = static_cast<double>(allocations) / frameMs.size();
+    result.bytesPerFrame = static_cast<double>(bytes) / frameMs.size();
+    for (auto &scope : scopeTotals)
+    {
+        if (scope.scope && scope.allocationsPerFrame > 0.0)
+        {
+            scope.allocationsPerFrame /= frameMs.size();
+            scope.bytesPerFrame /= frameMs.size();
+            result.allocationScopes.push_back(scope);
+        }
+    }
+    for (auto &layer : layerTotals)
+    {
+        if (layer.layer && layer.drawsPerFrame > 0.0)
+        {
+            layer.drawsPerFrame /= frameMs.size();
+            layer.verticesPerFrame /= frameMs.size();
+            layer.textureSwitchesPerFrame /= frameMs.size();
+            layer.blendChangesPerFrame /= frameMs.size();
+            result.renderLayers.push_back(layer);
+        }
+    }
+
+    double total = 0.0;
+    for (double ms : frameMs)
+    {
+        total += ms;
+    }
+    result.meanMs = total / frameMs.size();
+    std::sort(frameMs.begin(), frameMs.end());
+    result.p50Ms = percentile(frameMs, 50.0);
+    result.p95Ms = percentile(frameMs, 95.0);
+    result.p99Ms = percentile(frameMs, 99.0);
+    result.maxMs = frameMs.back();
+    return result;
+}
+
+void Benchmark::prepareScenario(BenchmarkScenario scenario)
+{
+    m_game.changeScene(GameState::Playing);
+    GameScene *scene = gameScene();
+    if (!scene)
+    {
+        return;
+    }
+    scene->m_rng.seed(BENCH_SEED);
+    scene->startLevel(BENCH_SEED); // same course every run
+    scene->m_invulnerable = true;
+    if (scenario == BenchmarkScenario::Lasers)
+    {
+        scene->m_lasers.reserve(STRESS_LASER_COUNT);
+    }
+    if (scenario == BenchmarkScenario::Particles)
+    {
+        scene->m_particles.setBudgetMs(0.f); // measure the full load, not the fallback
+    }
+}
+
+void Benchmark::stepScenario(BenchmarkScenario scenario, int frame)
+{
+    if (scenario == BenchmarkScenario::SceneSwitch)
+    {
+        m_game.changeScene(frame % 2 == 0 ? GameState::MainMenu : GameState::Playing);
+        if (GameScene *scene = gameScene())
+        {
+            scene->m_invulnerable = true;
+        }
+        return;
+    }
+
+    GameScene *scene = gameScene();
+    if (!scene)
+    {
+        return;
+    }
+    switch (scenario)
+    {
+    case BenchmarkScenario::Lasers:
+        topUpLasers(*scene, STRESS_LASER_COUNT);
+        break;
+    case BenchmarkScenario::BFieldDensity:
+    {
+        // enough B that sqrt(|B| * scale) exceeds the per row/col cap
+        float cap = static_cast<float>(GameScene::MAX_B_FIELD_SYMBOLS_PER_ROW_COL + 1);
+        scene->m_currentFields.magneticField_Z = (frame % 2 == 0 ? 1.f : -1.f) * cap * cap / GameScene::B_FIELD_DENSITY_SCALE_FACTOR;
+        scene->m_currentFields.electricField = {40.f, 0.f};
+        break;
+    }
+    case BenchmarkScenario::FieldChurn:
+        scene->randomizeFields();
+        break;
+    case BenchmarkScenario::Particles:
+        topUpParticles(*scene, STRESS_PARTICLE_COUNT);
+        break;
+    default:
+        break;
+    }
+}
+
+GameScene *Benchmark::gameScene()
+{
+    if (m_game.getCurrentState() != GameState::Playing)
+    {
+        return nullptr;
+    }
+    return dynamic_cast<GameScene *>(m_game.getCurrentScene());
+}
+
+void Benchmark::topUpLasers(GameScene &scene, std::size_t count)
+{
+    if (scene.m_laserRegion.width == 0)
+    {
+        return;
+    }
+    sf::Vector2u winSize = scene.m_game.getWindow().getSize();
+    while (scene.m_lasers.size() < count)
+    {
+        // spawn on screen (relative to the camera) so they live for a while before being culled
+        sf::Vector2f pos(static_cast<float>(scene.m_rng() % winSize.x), static_cast<float>(scene.m_rng() % winSize.y));
+        float speed = 150.f + (scene.m_rng() % 200);
+        switch (scene.m_rng() % 4)
+        {
+        case 0:
+            scene.addLaser(pos, sf::Vector2f(0.f, speed), 90.f);
+            break;
+        case 1:
+            scene.addLaser(pos, sf::Vector2f(0.f, -speed), -90.f);
+            break;
+        case 2:
+            scene.addLaser(pos, sf::Vector2f(speed, 0.f), 0.f);
+            break;
+        default:
+            scene.addLaser(pos, sf::Vector2f(-speed, 0.f), 180.f);
+            break;
+        }
+    }
+}
+
+void Benchmark::topUpParticles(GameScene &scene, std::size_t count)
+{
+    ParticleEmitter emitter;
+    emitter.speedMin = 20.f;
+    emitter.speedMax = 200.f;
+    emitter.lifeMin = 1.f;
+    emitter.lifeMax = 2.f;
+    emitter.color = sf::Color(255, 200, 120, 160);
+    sf::FloatRect view = scene.m_camera.getRect();
+    // a few bursts spread over the screen rather than one point
+    for (int burst = 0; burst < 8 && scene.m_particles.getCount() < count; ++burst)
+    {
+        sf::Vector2f pos(view.left + static_cast<float>(scene.m_rng() % 1000) / 1000.f * view.width,
+                         view.top + static_cast<float>(scene.m_rng() % 1000) / 1000.f * view.height);
+        std::size_t missing = count - scene.m_particles.getCount();
+        scene.m_particles.emit(emitter, pos, {1.f, 0.f}, static_cast<float>((missing + 7 - burst) / (8 - burst)));
+    }
+}
+
+double Benchmark::percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    // nearest rank
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+    rank = std::max<std::size_t>(1, std::min(rank, sorted.size()));
+    return sorted[rank - 1];
+}
+
+std::string Benchmark::toJson(const std::vector<BenchmarkResult> &results)
+{
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"timeStepMs\": " << BENCH_TIME_STEP * 1000.f << ",\n  \"scenarios\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult &r = results[i];
+        json << "    {\n"
+             << "      \"scene\": \"" << r.scenario << "\",\n"
+             << "      \"frames\": " << r.frames << ",\n"
+             << "      \"frameTimeMs\": {\"mean\": " << r.meanMs << ", \"p50\": " << r.p50Ms
+             << ", \"p95\": " << r.p95Ms << ", \"p99\": " << r.p99Ms << ", \"max\": " << r.maxMs << "},\n"
+             << "      \"inputLatencyMs\": {\"samples\": " << r.latencySamples << ", \"p50\": " << r.latencyP50Ms
+             << ", \"p95\": " << r.latencyP95Ms << ", \"p99\": " << r.latencyP99Ms << ", \"max\": " << r.latencyMaxMs << "},\n"
+             << "      \"allocationsPerFrame\": " << r.allocationsPerFrame << ",\n"
+             << "      \"bytesPerFrame\": " << r.bytesPerFrame << ",\n"
+             << "      \"frameArena\": {\"highWaterBytes\": " << r.arenaHighWaterBytes << ", \"overflows\": " << r.arenaOverflows << "},\n"
+             << "      \"allocationScopes\": {";
+        for (std::size_t j = 0; j < r.allocationScopes.size(); ++j)
+        {
+            const BenchmarkScopeAllocations &scope = r.allocationScopes[j];
+            json << (j > 0 ? ", " : "") << "\"" << scope.scope << "\": {\"allocationsPerFrame\": " << scope.allocationsPerFrame
+                 << ", \"bytesPerFrame\": " << scope.bytesPerFrame << "}";
+        }
+        json << "},\n"
+             << "      \"renderLayers\": {";
+        for (std::size_t j = 0; j < r.renderLayers.size(); ++j)
+        {
+            const BenchmarkRenderLayer &layer = r.renderLayers[j];
+            json << (j > 0 ? ", " : "") << "\"" << layer.layer << "\": {\"drawsPerFrame\": " << layer.drawsPerFrame
+                 << ", \"verticesPerFrame\": " << layer.verticesPerFrame
+                 << ", \"textureSwitchesPerFrame\": " << layer.textureSwitchesPerFrame
+                 << ", \"blendChangesPerFrame\": " << layer.blendChangesPerFrame << "}";
+        }
+        json << "}\n"
+             << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
@@ -0,0 +1,105 @@
+// src/core/Benchmark.h
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class Game;
+class GameScene;
+
+// scripted stress scenarios for --bench <scene>
+enum class BenchmarkScenario
+{
+    Steady,        // plain gameplay, what --fail-on-alloc checks
+    Lasers,        // 10k lasers alive at once
+    BFieldDensity, // B field symbol grid at MAX_B_FIELD_SYMBOLS_PER_ROW_COL
+    FieldChurn,    // fields randomized every frame
+    SceneSwitch,   // MenuScene <-> GameScene every frame
+    Particles      // 200k particles alive at once, no particle budget
+};
+
+struct BenchmarkOptions
+{
+    std::string scenario = "all";
+    int frames = 1000;
+    int warmupFrames = 60;
+    std::string outputPath; // empty: bench_<scenario>.json
+    bool failOnAllocation = false; // --fail-on-alloc: any main thread allocation in a measured frame fails the run
+};
+
+struct BenchmarkScopeAllocations
+{
+    const char *scope = nullptr;
+    double allocationsPerFrame = 0.0;
+    double bytesPerFrame = 0.0;
+};
+
+struct BenchmarkRenderLayer
+{
+    const char *layer = nullptr;
+    double drawsPerFrame = 0.0;
+    double verticesPerFrame = 0.0;
+    double textureSwitchesPerFrame = 0.0;
+    double blendChangesPerFrame = 0.0;
+};
+
+struct BenchmarkResult
+{
+    std::string scenario;
+    int frames = 0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double allocationsPerFrame = 0.0;
+    double bytesPerFrame = 0.0;
+    std::size_t totalAllocations = 0;
+    std::size_t arenaHighWaterBytes = 0;
+    std::size_t arenaOverflows = 0;
+    // a synthetic key stamped just before event polling in every measured frame
+    std::size_t latencySamples = 0;
+    double latencyP50Ms = 0.0;
+    double latencyP95Ms = 0.0;
+    double latencyP99Ms = 0.0;
+    double latencyMaxMs = 0.0;
+    std::vector<BenchmarkScopeAllocations> allocationScopes;
+    std::vector<BenchmarkRenderLayer> renderLayers;
+};
+
+class Benchmark
+{
+public:
+    Benchmark(Game &game, const BenchmarkOptions &options);
+
+    // runs the selected scenario(s) and writes the json report
+    // false on bad scenario name, or on any allocation with failOnAllocation set
+    bool run();
+
+    static bool parseScenario(const std::string &name, BenchmarkScenario &scenario);
+    static const char *scenarioName(BenchmarkScenario scenario);
+
+    // spawns on-screen lasers until the scene holds count of them, shared with DenPaKid_bench
+    static void topUpLasers(GameScene &scene, std::size_t count);
+    static void topUpParticles(GameScene &scene, std::size_t count);
+
+    static constexpr std::size_t STRESS_LASER_COUNT = 10000;
+    static constexpr std::size_t STRESS_PARTICLE_COUNT = 200000;
+
+private:
+    BenchmarkResult runScenario(BenchmarkScenario scenario);
+    void prepareScenario(BenchmarkScenario scenario);
+    void stepScenario(BenchmarkScenario scenario, int frame);
+    GameScene *gameScene();
+
+    static void reportAllocations(const BenchmarkResult &result);
+    static double percentile(const std::vector<double> &sorted, double p);
+    static std::string toJson(const std::vector<BenchmarkResult> &results);
+
+    Game &m_game;
+    BenchmarkOptions m_options;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,137 @@
+// src/core/FlightRecorder.cpp
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+bool FlightRecorder::record(const Profiler &profiler)
+{
+    m_newest = (m_newest + 1) % MAX_FRAMES;
+    m_frameCount = std::min(m_frameCount + 1, MAX_FRAMES);
+    Frame &current = m_frames[m_newest];
+    current.index = profiler.getFrameIndex() - 1; // endFrame already counted it
+    current.ms = static_cast<float>(profiler.getFrameTimeMs());
+    current.allocations = profiler.getFrameAllocations();
+    current.bytes = profiler.getFrameBytes();
+    current.scopeCount = profiler.getScopeCount();
+    for (std::size_t i = 0; i < current.scopeCount; ++i)
+    {
+        const ProfileScopeStats &scope = profiler.getScope(i);
+        m_scopeNames[i] = scope.name;
+        current.scopeMs[i] = static_cast<float>(scope.timeMs);
+        current.scopeCalls[i] = scope.calls;
+        current.scopeAllocations[i] = scope.allocations;
+    }
+
+    if (m_budgetMs <= 0.0 || current.ms <= m_budgetMs)
+    {
+        return false;
+    }
+    Clock::time_point now = Clock::now();
+    if (m_reportCount > 0 && std::chrono::duration<double, std::milli>(now - m_lastReport).count() < REPORT_COOLDOWN_MS)
+    {
+        return false;
+    }
+    m_lastReport = now;
+    return true;
+}
+
+void FlightRecorder::onSceneChange(const char *name)
+{
+    SceneChange &change = m_sceneChanges[m_sceneChangeCount % MAX_SCENE_CHANGES];
+    change.name = name;
+    change.frame = Profiler::getInstance().getFrameIndex(); // the frame in progress
+    change.when = Clock::now();
+    ++m_sceneChangeCount;
+}
+
+bool FlightRecorder::writeReport(const DebugCounter *counters, std::size_t counterCount, std::string &path)
+{
+    if (m_frameCount == 0)
+    {
+        return false;
+    }
+    const Frame &hitch = frame(0);
+    path = "hitch_" + std::to_string(hitch.index) + ".txt";
+    std::ofstream out(path);
+    if (!out)
+    {
+        return false;
+    }
+    ++m_reportCount;
+    out << std::fixed << std::setprecision(3);
+    out << "frame " << hitch.index << " took " << hitch.ms << " ms, budget " << m_budgetMs << " ms\n"
+        << "allocations " << hitch.allocations << " (" << hitch.bytes << " bytes)\n\n";
+
+    // this frame, slowest first. times are inclusive, nested scopes also count towards their parents
+    std::array<std::size_t, Profiler::MAX_SCOPES> order{};
+    for (std::size_t i = 0; i < hitch.scopeCount; ++i)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.begin() + hitch.scopeCount,
+              [&hitch](std::size_t l, std::size_t r)
+              { return hitch.scopeMs[l] > hitch.scopeMs[r]; });
+    out << "scopes (inclusive ms, calls, allocations):\n";
+    for (std::size_t n = 0; n < hitch.scopeCount; ++n)
+    {
+        std::size_t i = order[n];
+        if (hitch.scopeCalls[i] == 0)
+        {
+            continue;
+        }
+        out << "  " << std::left << std::setw(18) << m_scopeNames[i] << std::right << std::setw(10) << hitch.scopeMs[i]
+            << " x" << hitch.scopeCalls[i] << "  " << hitch.scopeAllocations[i] << " a\n";
+    }
+
+    out << "\ncounters:\n";
+    for (std::size_t i = 0; i < counterCount; ++i)
+    {
+        out << "  " << std::left << std::setw(18) << counters[i].name << std::right << counters[i].value << "\n";
+    }
+
+    out << "\nrecent scene changes:\n";
+    Clock::time_point now = Clock::now();
+    std::size_t changes = std::min(m_sceneChangeCount, MAX_SCENE_CHANGES);
+    for (std::size_t n = changes; n-- > 0;)
+    {
+        const SceneChange &change = m_sceneChanges[(m_sceneChangeCount - 1 - n) % MAX_SCENE_CHANGES];
+        out << "  frame " << change.frame << " (" << std::chrono::duration<double>(now - change.when).count() << " s ago): "
+            << change.name << "\n";
+    }
+
+    // the frames leading up to it, oldest first, as far back as HISTORY_MS
+    std::size_t history = 1;
+    double historyMs = hitch.ms;
+    while (history < m_frameCount && historyMs < HISTORY_MS)
+    {
+        historyMs += frame(history).ms;
+        ++history;
+    }
+    std::array<double, Profiler::MAX_SCOPES> scopeTotal{};
+    std::array<float, Profiler::MAX_SCOPES> scopeMax{};
+    std::size_t overBudget = 0;
+    for (std::size_t age = 0; age < history; ++age)
+    {
+        const Frame &f = frame(age);
+        overBudget += f.ms > m_budgetMs ? 1 : 0;
+        for (std::size_t i = 0; i < f.scopeCount; ++i)
+        {
+            scopeTotal[i] += f.scopeMs[i];
+            scopeMax[i] = std::max(scopeMax[i], f.scopeMs[i]);
+        }
+    }
+    out << "\nlast " << historyMs / 1000.0 << " s: " << history << " frames, " << overBudget << " over budget\n"
+        << "scopes (mean ms, max ms):\n";
+    for (std::size_t i = 0; i < hitch.scopeCount; ++i)
+    {
+        out << "  " << std::left << std::setw(18) << m_scopeNames[i] << std::right << std::setw(10) << scopeTotal[i] / history
+            << std::setw(10) << scopeMax[i] << "\n";
+    }
+    out << "frame times (ms, oldest first):\n";
+    for (std::size_t age = history; age-- > 0;)
+    {
+        out << "  " << frame(age).index << " " << frame(age).ms << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,81 @@
+// src/core/FlightRecorder.h
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Profiler.h"
+
+// a named number a scene reports for hitch reports, e.g. how many lasers are alive
+struct DebugCounter
+{
+    const char *name = nullptr;
+    std::size_t value = 0;
+};
+
+// keeps per-scope timings of the last HISTORY_MS of frames, preallocated. a frame over the budget
+// makes record() return true, Game then calls writeReport() with what the scene has alive
+class FlightRecorder
+{
+public:
+    static constexpr std::size_t MAX_FRAMES = 1024; // HISTORY_MS at up to ~500 fps
+    static constexpr double HISTORY_MS = 2000.0;
+    static constexpr std::size_t MAX_SCENE_CHANGES = 16;
+    static constexpr double REPORT_COOLDOWN_MS = 1000.0; // writing a report is itself a hitch, don't cascade
+
+    // 0 = never report
+    void setBudgetMs(double ms) { m_budgetMs = ms; }
+    double getBudgetMs() const { return m_budgetMs; }
+
+    // after Profiler::endFrame, true if the frame went over budget and a report is due
+    bool record(const Profiler &profiler);
+
+    // name must outlive the recorder, e.g. a string literal
+    void onSceneChange(const char *name);
+
+    // hitch_<frame>.txt in the working directory, path in out
+    bool writeReport(const DebugCounter *counters, std::size_t counterCount, std::string &path);
+
+    std::size_t getReportCount() const { return m_reportCount; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        unsigned long long index = 0;
+        float ms = 0.f;
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        std::size_t scopeCount = 0;
+        std::array<float, Profiler::MAX_SCOPES> scopeMs{};
+        std::array<int, Profiler::MAX_SCOPES> scopeCalls{};
+        std::array<std::size_t, Profiler::MAX_SCOPES> scopeAllocations{};
+    };
+
+    struct SceneChange
+    {
+        const char *name = nullptr;
+        unsigned long long frame = 0;
+        Clock::time_point when;
+    };
+
+    const Frame &frame(std::size_t age) const { return m_frames[(m_newest + MAX_FRAMES - age) % MAX_FRAMES]; }
+
+    double m_budgetMs = 0.0;
+    std::vector<Frame> m_frames = std::vector<Frame>(MAX_FRAMES); // ~800 KB, Game lives on the stack
+    std::size_t m_newest = MAX_FRAMES - 1;
+    std::size_t m_frameCount = 0;
+    std::array<const char *, Profiler::MAX_SCOPES> m_scopeNames{}; // slots are stable across frames
+
+    std::array<SceneChange, MAX_SCENE_CHANGES> m_sceneChanges{};
+    std::size_t m_sceneChangeCount = 0;
+
+    Clock::time_point m_lastReport{};
+    std::size_t m_reportCount = 0;
+};
+
+#endif // FLIGHTRECORDER_H
@@ -0,0 +1,75 @@
+// src/core/FrameArena.cpp
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_buffer(new unsigned char[capacity]), m_capacity(capacity)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+void FrameArena::reset()
+{
+    m_highWaterMark = std::max(m_highWaterMark, getUsed());
+    m_used = 0;
+    releaseOverflow();
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    std::uintptr_t aligned = (base + m_used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t newUsed = static_cast<std::size_t>(aligned - base) + bytes;
+    if (newUsed > m_capacity)
+    {
+        return allocateOverflow(bytes, alignment);
+    }
+    m_used = newUsed;
+    m_highWaterMark = std::max(m_highWaterMark, getUsed());
+    return reinterpret_cast<void *>(aligned);
+}
+
+void FrameArena::do_deallocate(void *, std::size_t, std::size_t)
+{
+}
+
+void *FrameArena::allocateOverflow(std::size_t bytes, std::size_t alignment)
+{
+    if (!m_overflowWarned)
+    {
+        std::cerr << "Warning: FrameArena of " << m_capacity << " bytes overflowed, raise its capacity." << std::endl;
+        m_overflowWarned = true;
+    }
+    // header first, payload at the next multiple of the requested alignment
+    std::size_t blockAlignment = std::max(alignment, alignof(OverflowBlock));
+    std::size_t headerSize = (sizeof(OverflowBlock) + blockAlignment - 1) & ~(blockAlignment - 1);
+    std::size_t blockSize = headerSize + bytes;
+    void *raw = std::pmr::new_delete_resource()->allocate(blockSize, blockAlignment);
+
+    OverflowBlock *block = static_cast<OverflowBlock *>(raw);
+    block->next = m_overflow;
+    block->size = blockSize;
+    block->alignment = blockAlignment;
+    m_overflow = block;
+    m_overflowBytes += bytes;
+    ++m_overflowCount;
+    m_highWaterMark = std::max(m_highWaterMark, getUsed());
+    return static_cast<unsigned char *>(raw) + headerSize;
+}
+
+void FrameArena::releaseOverflow()
+{
+    while (m_overflow)
+    {
+        OverflowBlock *next = m_overflow->next;
+        std::pmr::new_delete_resource()->deallocate(m_overflow, m_overflow->size, m_overflow->alignment);
+        m_overflow = next;
+    }
+    m_overflowBytes = 0;
+}
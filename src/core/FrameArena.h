@@ -0,0 +1,58 @@
+// src/core/FrameArena.h
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// bump allocator for per-frame transient data, reset at the top of every Game::run iteration
+// use it through std::pmr containers: std::pmr::vector<int> ids(&m_game.getFrameArena());
+// anything allocated from it must not outlive the frame
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    // drops everything allocated this frame, and any overflow blocks
+    void reset();
+
+    std::size_t getCapacity() const { return m_capacity; }
+    std::size_t getUsed() const { return m_used + m_overflowBytes; }
+    std::size_t getHighWaterMark() const { return m_highWaterMark; } // largest frame so far, use it to size the arena
+    std::size_t getOverflowCount() const { return m_overflowCount; }  // allocations that missed the arena, since start
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override; // no-op, reset() frees
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    void *allocateOverflow(std::size_t bytes, std::size_t alignment);
+    void releaseOverflow();
+
+    struct OverflowBlock
+    {
+        OverflowBlock *next;
+        std::size_t size;
+        std::size_t alignment;
+    };
+
+    std::unique_ptr<unsigned char[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_used = 0;
+    std::size_t m_highWaterMark = 0;
+
+    // when a frame needs more than the arena, spill to the heap and say so once
+    OverflowBlock *m_overflow = nullptr;
+    std::size_t m_overflowBytes = 0;
+    std::size_t m_overflowCount = 0;
+    bool m_overflowWarned = false;
+};
+
+#endif // FRAMEARENA_H
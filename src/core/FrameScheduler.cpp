@@ -0,0 +1,61 @@
+// src/core/FrameScheduler.cpp
+#include "FrameScheduler.h"
+#include <SFML/System/Sleep.hpp>
+#include <thread>
+
+void FrameScheduler::setFpsCap(unsigned int fps)
+{
+    m_fpsCap = fps;
+    if (fps > 0)
+    {
+        m_framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    }
+    m_nextFrame = Clock::now();
+}
+
+void FrameScheduler::onEvent(const sf::Event &event)
+{
+    if (event.type == sf::Event::LostFocus)
+    {
+        m_focused = false;
+    }
+    else if (event.type == sf::Event::GainedFocus)
+    {
+        m_focused = true;
+    }
+}
+
+void FrameScheduler::waitForNextFrame()
+{
+    if (m_fpsCap == 0)
+    {
+        return;
+    }
+    Clock::time_point now = Clock::now();
+    m_nextFrame += m_framePeriod;
+    if (m_nextFrame < now - m_framePeriod)
+    {
+        // fell more than a frame behind (hitch, breakpoint), don't try to catch up
+        m_nextFrame = now;
+        return;
+    }
+
+    const Clock::duration spinThreshold = std::chrono::microseconds(SPIN_THRESHOLD_US);
+    while (true)
+    {
+        Clock::duration remaining = m_nextFrame - Clock::now();
+        if (remaining <= Clock::duration::zero())
+        {
+            return;
+        }
+        if (remaining > spinThreshold)
+        {
+            sf::sleep(sf::microseconds(static_cast<sf::Int64>(
+                std::chrono::duration_cast<std::chrono::microseconds>(remaining - spinThreshold).count())));
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,40 @@
+// src/core/FrameScheduler.h
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <SFML/Window/Event.hpp>
+#include <chrono>
+
+// decides when Game::run may do nothing: pauses the simulation without focus and
+// paces frames to an optional fps cap
+class FrameScheduler
+{
+public:
+    // 0 = no cap, vsync (if on) does the pacing
+    void setFpsCap(unsigned int fps);
+    unsigned int getFpsCap() const { return m_fpsCap; }
+
+    // benchmark mode keeps running in the background
+    void setPauseWhenUnfocused(bool pause) { m_pauseWhenUnfocused = pause; }
+
+    // tracks LostFocus/GainedFocus
+    void onEvent(const sf::Event &event);
+    bool isFocused() const { return m_focused; }
+    bool isSimulationPaused() const { return m_pauseWhenUnfocused && !m_focused; }
+
+    // called after display(): sleeps most of the remaining frame, spins the last bit for accuracy
+    void waitForNextFrame();
+
+    static constexpr long long SPIN_THRESHOLD_US = 2000; // OS sleep is too coarse below this
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    unsigned int m_fpsCap = 0;
+    Clock::duration m_framePeriod{};
+    Clock::time_point m_nextFrame{};
+    bool m_focused = true;
+    bool m_pauseWhenUnfocused = true;
+};
+
+#endif // FRAMESCHEDULER_H
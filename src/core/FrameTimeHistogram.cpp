@@ -0,0 +1,107 @@
+// src/core/FrameTimeHistogram.cpp
+#include "FrameTimeHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+void FrameTimeHistogram::record(double ms)
+{
+    auto us = static_cast<std::uint64_t>(std::llround(std::max(0.0, ms) * 1000.0));
+    ++m_buckets[indexOf(us)];
+    m_minUs = m_count == 0 ? us : std::min(m_minUs, us);
+    m_maxUs = std::max(m_maxUs, us);
+    m_totalUs += static_cast<double>(us);
+    ++m_count;
+}
+
+void FrameTimeHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_totalUs = 0.0;
+    m_minUs = 0;
+    m_maxUs = 0;
+}
+
+double FrameTimeHistogram::getPercentileMs(double p) const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+    auto rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(m_count)));
+    rank = std::max<std::uint64_t>(1, std::min(rank, m_count));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            std::uint64_t highest = i + 1 < BUCKET_COUNT ? lowestOf(i + 1) - 1 : m_maxUs;
+            return std::min(highest, m_maxUs) / 1000.0;
+        }
+    }
+    return getMaxMs();
+}
+
+bool FrameTimeHistogram::writeJson(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        return false;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"frames\": " << m_count << ",\n"
+        << "  \"meanMs\": " << getMeanMs() << ", \"minMs\": " << getMinMs() << ", \"maxMs\": " << getMaxMs() << ",\n"
+        << "  \"percentilesMs\": {\"p50\": " << getPercentileMs(50.0) << ", \"p90\": " << getPercentileMs(90.0)
+        << ", \"p99\": " << getPercentileMs(99.0) << ", \"p99.9\": " << getPercentileMs(99.9)
+        << ", \"p99.99\": " << getPercentileMs(99.99) << "},\n"
+        << "  \"buckets\": [";
+    // [lowest ms, highest ms, frames]
+    bool first = true;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        if (m_buckets[i] == 0)
+        {
+            continue;
+        }
+        std::uint64_t highest = i + 1 < BUCKET_COUNT ? lowestOf(i + 1) - 1 : m_maxUs;
+        out << (first ? "\n    " : ",\n    ") << "[" << lowestOf(i) / 1000.0 << ", " << highest / 1000.0 << ", " << m_buckets[i] << "]";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+std::size_t FrameTimeHistogram::indexOf(std::uint64_t us)
+{
+    if (us < SUB_BUCKETS)
+    {
+        return static_cast<std::size_t>(us);
+    }
+    int top = SUB_BUCKET_BITS;
+    while ((us >> (top + 1)) != 0)
+    {
+        ++top;
+    }
+    // values in [2^top, 2^(top+1)) share a shift, the bits below the top SUB_BUCKET_BITS are dropped
+    int shift = top - SUB_BUCKET_BITS + 1;
+    if (shift > MAX_BITS - SUB_BUCKET_BITS)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    return SUB_BUCKETS + (shift - 1) * HALF_BUCKETS + static_cast<std::size_t>((us >> shift) - HALF_BUCKETS);
+}
+
+std::uint64_t FrameTimeHistogram::lowestOf(std::size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+    std::size_t k = index - SUB_BUCKETS;
+    int shift = static_cast<int>(k / HALF_BUCKETS) + 1;
+    return static_cast<std::uint64_t>(HALF_BUCKETS + k % HALF_BUCKETS) << shift;
+}
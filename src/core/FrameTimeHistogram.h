@@ -0,0 +1,45 @@
+// src/core/FrameTimeHistogram.h
+#ifndef FRAMETIMEHISTOGRAM_H
+#define FRAMETIMEHISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// every frame of the session in log-linear buckets (HdrHistogram style): exact below 128 us,
+// then 64 buckets per power of two, so any value is within ~1.6% at a fixed ~11 KB whatever the session length
+class FrameTimeHistogram
+{
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BUCKET_BITS;
+    static constexpr std::size_t HALF_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr int MAX_BITS = 27; // microseconds, ~134 s, longer frames land in the last bucket
+    static constexpr std::size_t BUCKET_COUNT = SUB_BUCKETS + (MAX_BITS - SUB_BUCKET_BITS) * HALF_BUCKETS;
+
+    void record(double ms);
+    void reset();
+
+    std::uint64_t getCount() const { return m_count; }
+    double getMeanMs() const { return m_count > 0 ? m_totalUs / 1000.0 / m_count : 0.0; }
+    double getMinMs() const { return m_count > 0 ? m_minUs / 1000.0 : 0.0; }
+    double getMaxMs() const { return m_maxUs / 1000.0; }
+    // highest value equivalent to the nearest-rank bucket, never above the max
+    double getPercentileMs(double p) const;
+
+    // summary, percentiles and the non-empty buckets
+    bool writeJson(const std::string &path) const;
+
+private:
+    static std::size_t indexOf(std::uint64_t us);
+    static std::uint64_t lowestOf(std::size_t index);
+
+    std::array<std::uint64_t, BUCKET_COUNT> m_buckets{};
+    std::uint64_t m_count = 0;
+    double m_totalUs = 0.0;
+    std::uint64_t m_minUs = 0;
+    std::uint64_t m_maxUs = 0;
+};
+
+#endif // FRAMETIMEHISTOGRAM_H
@@ -3,8 +3,30 @@
 #include "../scene/MenuScene.h"
 #include "../scene/GameScene.h"
 #include "../render/ResourceManager.h"
+#include "Profiler.h"
 #include <iostream>
 
+namespace
+{
+    const char *stateName(GameState state)
+    {
+        switch (state)
+        {
+        case GameState::MainMenu:
+            return "MainMenu";
+        case GameState::Playing:
+            return "Playing";
+        case GameState::GameOver:
+            return "GameOver";
+        case GameState::ViewingScroll:
+            return "ViewingScroll";
+        case GameState::GameWon:
+            return "GameWon";
+        }
+        return "unknown";
+    }
+}
+
 Game::Game(unsigned int width, unsigned int height, const std::string &title)
     : m_window(sf::VideoMode(width, height), title),
       m_currentState(GameState::MainMenu),
@@ -12,6 +34,14 @@ Game::Game(unsigned int width, unsigned int height, const std::string &title)
 {
     std::cout << "initiating Game./ Game.cpp" << std::endl;
     m_window.setVerticalSyncEnabled(true);
+    m_audioMixer.setMasterGain(m_masterVolume / 100.f);
+    m_audioMixer.play();
+
+    // both themes stay open for the session, scenes only crossfade between them
+    m_musicService.openTrack(MusicTrack::Menu, "../../assets/audio/menu_theme.ogg", 1.f);
+    m_musicService.openTrack(MusicTrack::Game, "../../assets/audio/game_theme.ogg", 0.7f);
+    m_musicService.setMasterGain(m_masterVolume / 100.f);
+    m_musicService.play();
 
     m_scrollContents.resize(m_totalScrolls);
 
@@ -35,6 +65,12 @@ Game::Game(unsigned int width, unsigned int height, const std::string &title)
         m_deathScrollText.setFont(m_font);
         m_deathScrollText.setCharacterSize(24);
         m_deathScrollText.setFillColor(sf::Color::White);
+
+        m_profilerOverlay.setFont(m_font);
+        m_profilerOverlay.setFrameArena(&m_frameArena);
+        m_profilerOverlay.setLatencyTracker(&m_latencyTracker);
+        m_profilerOverlay.setRenderStats(&m_renderStats);
+        m_profilerOverlay.setQualityGovernor(&m_quality);
     }
     catch (const std::runtime_error &e)
     {
@@ -51,57 +87,193 @@ Game::~Game()
 void Game::run()
 {
     sf::Clock clock;
+    Profiler &profiler = Profiler::getInstance();
     while (m_window.isOpen() && !m_exitGame)
     {
+        if (isIdle())
+        {
+            // nothing on screen would change, sleep in the OS until something happens
+            waitForEvent();
+            clock.restart();
+        }
         sf::Time deltaTime = clock.restart();
+        m_frameArena.reset();
+        profiler.beginFrame();
         processEvents();
         update(deltaTime);
         render();
+        profiler.endFrame();
+        m_frameTimes.record(profiler.getFrameTimeMs());
+        if (m_flightRecorder.record(profiler))
+        {
+            writeHitchReport();
+        }
+        if (m_quality.onFrame(profiler.getFrameTimeMs(), profiler.getScopeTimeMs("display")))
+        {
+            applyQuality();
+        }
+        m_frameScheduler.waitForNextFrame();
+    }
+
+    if (m_frameTimes.writeJson("frame_times.json"))
+    {
+        std::cout << "Frame times: " << m_frameTimes.getCount() << " frames, p50 " << m_frameTimes.getPercentileMs(50.0)
+                  << " ms, p99 " << m_frameTimes.getPercentileMs(99.0) << " ms, p99.9 " << m_frameTimes.getPercentileMs(99.9)
+                  << " ms, max " << m_frameTimes.getMaxMs() << " ms (frame_times.json)" << std::endl;
+    }
+}
+
+void Game::writeHitchReport()
+{
+    DebugCounter counters[16];
+    std::size_t count = m_currentScene ? m_currentScene->getDebugCounters(counters, 16) : 0;
+    std::string path;
+    if (m_flightRecorder.writeReport(counters, count, path))
+    {
+        std::cerr << "Hitch: frame over " << m_flightRecorder.getBudgetMs() << " ms, report in " << path << std::endl;
+    }
+}
+
+void Game::setQualityLevel(int level)
+{
+    m_quality.setAutomatic(false);
+    m_quality.setLevel(level);
+    applyQuality();
+}
+
+void Game::applyQuality()
+{
+    m_audioMixer.setVoiceLimit(m_quality.getSettings().audioVoices);
+    if (m_currentScene)
+    {
+        m_currentScene->onQualityChanged();
     }
 }
 
 void Game::processEvents()
 {
+    PROFILE_SCOPE("events");
     sf::Event event;
     while (m_window.pollEvent(event))
     {
-        if (event.type == sf::Event::Closed)
-        {
-            m_window.close();
-        }
-        if (m_currentScene)
-        {
-            m_currentScene->handleInput(event, m_window);
-        }
-        if (m_currentState == GameState::GameWon && event.type == sf::Event::KeyPressed)
-        {
-            m_exitGame = true;
-        }
-        if (m_currentState == GameState::GameOver && event.type == sf::Event::KeyPressed)
+        handleEvent(event);
+    }
+}
+
+void Game::waitForEvent()
+{
+    sf::Event event;
+    if (m_window.waitEvent(event))
+    {
+        handleEvent(event);
+    }
+}
+
+bool Game::isIdle() const
+{
+    if (!m_currentScene || m_presentRequested || m_profilerOverlay.isVisible())
+    {
+        return false;
+    }
+    switch (m_currentState)
+    {
+    case GameState::MainMenu:
+        return !m_currentScene->needsPresent();
+    case GameState::GameOver:
+    case GameState::GameWon:
+        return true; // text screens only change on key presses
+    default:
+        return m_frameScheduler.isSimulationPaused();
+    }
+}
+
+void Game::handleEvent(sf::Event &event)
+{
+    if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
+    {
+        // SFML events carry no timestamp, polling is the earliest the game knows
+        m_latencyTracker.onInput(LatencyTracker::Clock::now());
+    }
+    if (event.type == sf::Event::Closed)
+    {
+        m_window.close();
+    }
+    if (event.type == sf::Event::LostFocus || event.type == sf::Event::GainedFocus)
+    {
+        m_frameScheduler.onEvent(event);
+        onFocusChanged();
+    }
+    if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus)
+    {
+        m_presentRequested = true;
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
+    {
+        m_profilerOverlay.toggle();
+        m_presentRequested = true; // also clears the overlay off an idle screen
+        return;
+    }
+    if (m_currentScene)
+    {
+        m_currentScene->handleInput(event, m_window);
+    }
+    if (m_currentState == GameState::GameWon && event.type == sf::Event::KeyPressed)
+    {
+        m_exitGame = true;
+    }
+    if (m_currentState == GameState::GameOver && event.type == sf::Event::KeyPressed)
+    {
+        if (!m_newlyCollectedScrolls.empty())
         {
+            m_newlyCollectedScrolls.erase(m_newlyCollectedScrolls.begin());
+
             if (!m_newlyCollectedScrolls.empty())
             {
-                m_newlyCollectedScrolls.erase(m_newlyCollectedScrolls.begin());
-
-                if (!m_newlyCollectedScrolls.empty())
-                {
-                    prepareNextScrollForDisplay();
-                }
-                else
-                {
-                    changeScene(GameState::MainMenu);
-                }
+                prepareNextScrollForDisplay();
             }
             else
             {
                 changeScene(GameState::MainMenu);
             }
         }
+        else
+        {
+            changeScene(GameState::MainMenu);
+        }
+    }
+}
+
+void Game::onFocusChanged()
+{
+    // game music pauses with the simulation, the menu keeps playing
+    if (m_currentState != GameState::Playing)
+    {
+        return;
+    }
+    if (m_frameScheduler.isSimulationPaused() && m_musicService.getStatus() == sf::SoundSource::Playing)
+    {
+        m_musicService.pause();
+        m_musicPausedForFocus = true;
+    }
+    else if (!m_frameScheduler.isSimulationPaused() && m_musicPausedForFocus)
+    {
+        m_musicService.play();
+        m_musicPausedForFocus = false;
     }
 }
 
 void Game::update(sf::Time deltaTime)
 {
+    PROFILE_SCOPE("update");
+    {
+        PROFILE_SCOPE("overlay");
+        m_profilerOverlay.update(deltaTime);
+    }
+    if (m_frameScheduler.isSimulationPaused())
+    {
+        return;
+    }
+    m_latencyTracker.onSimulationTick();
     if (m_currentScene && (m_currentState != GameState::GameWon && m_currentState != GameState::GameOver))
     {
         m_currentScene->update(deltaTime);
@@ -110,25 +282,52 @@ void Game::update(sf::Time deltaTime)
 
 void Game::render()
 {
-    m_window.clear(sf::Color::Black);
+    PROFILE_SCOPE("render");
+    if (isIdle())
+    {
+        // last presented frame is still on screen
+        return;
+    }
+    m_presentRequested = false;
+    m_renderStats.beginFrame();
+    InstrumentedRenderTarget target(m_window, m_renderStats);
+    target.clear(sf::Color::Black);
     if (m_currentScene && (m_currentState != GameState::GameWon && m_currentState != GameState::GameOver))
     {
-        m_currentScene->render(m_window);
+        m_currentScene->render(target);
     }
     else if (m_currentState == GameState::GameWon)
     {
-        m_window.draw(m_winText);
+        target.setLayer("screen");
+        target.draw(m_winText);
     }
     else if (m_currentState == GameState::GameOver)
     {
-        m_window.draw(m_deathScrollText);
+        target.setLayer("screen");
+        target.draw(m_deathScrollText);
     }
+    m_renderStats.endFrame();
+    // straight to the window, the overlay doesn't count itself
+    m_profilerOverlay.draw(m_window);
+
+    PROFILE_SCOPE("display");
     m_window.display();
+    // with vsync display() returns at the swap, the closest to photons the game can see
+    m_latencyTracker.onPresent(LatencyTracker::Clock::now());
 }
 
 void Game::changeScene(GameState newState)
 {
+    PROFILE_SCOPE("changeScene");
+    m_flightRecorder.onSceneChange(stateName(newState));
+    m_quality.onSceneChange();
     m_currentState = newState;
+    m_presentRequested = true;
+    if (m_musicPausedForFocus)
+    {
+        m_musicService.play();
+        m_musicPausedForFocus = false;
+    }
     // Reset last collected scroll on scene change
     m_gameWonMessageDisplayed = false;
 
@@ -139,13 +338,27 @@ void Game::changeScene(GameState newState)
         m_newlyCollectedScrolls.clear();
     }
 
+    // scenes are pooled: built and loaded on first use, then only suspended and re-entered
+    Scene *nextScene = m_currentScene;
     if (m_currentState == GameState::MainMenu)
     {
-        m_currentScene = std::make_unique<MenuScene>(*this);
+        if (!m_menuScene)
+        {
+            PROFILE_SCOPE("loadAssets");
+            m_menuScene = std::make_unique<MenuScene>(*this);
+            m_menuScene->loadAssets();
+        }
+        nextScene = m_menuScene.get();
     }
     else if (m_currentState == GameState::Playing)
     {
-        m_currentScene = std::make_unique<GameScene>(*this);
+        if (!m_gameScene)
+        {
+            PROFILE_SCOPE("loadAssets");
+            m_gameScene = std::make_unique<GameScene>(*this);
+            m_gameScene->loadAssets();
+        }
+        nextScene = m_gameScene.get();
     }
     else if (m_currentState == GameState::GameOver)
     {
@@ -156,16 +369,33 @@ void Game::changeScene(GameState newState)
     {
         // No new scene, Game loop handles win message
     }
-    if (m_currentScene)
+
+    if (nextScene != m_currentScene)
+    {
+        if (m_currentScene)
+        {
+            m_currentScene->onExit();
+        }
+        m_currentScene = nextScene;
+        if (m_currentScene)
+        {
+            m_currentScene->onEnter();
+            m_currentScene->onQualityChanged(); // may have changed while it was suspended
+        }
+    }
+    else if (m_currentScene && (newState == GameState::Playing || newState == GameState::MainMenu))
     {
-        m_currentScene->loadAssets();
+        // re-entering the same scene is a restart
+        m_currentScene->onEnter();
     }
 }
 
 void Game::setMasterVolume(float volume)
 {
     m_masterVolume = std::max(0.0f, std::min(100.0f, volume));
-    // scenes will need to query this
+    m_audioMixer.setMasterGain(m_masterVolume / 100.f);
+    m_musicService.setMasterGain(m_masterVolume / 100.f);
+    // scenes only update their own UI
     if (m_currentScene)
     {
         m_currentScene->onVolumeChanged();
@@ -205,6 +435,7 @@ void Game::prepareNextScrollForDisplay()
     }
 
     m_deathScrollText.setString("You found a scroll: \n\n" + content);
+    m_presentRequested = true;
     sf::FloatRect bounds = m_deathScrollText.getLocalBounds();
     m_deathScrollText.setOrigin(bounds.width / 2.0f, bounds.height / 2.0f);
     m_deathScrollText.setPosition(m_window.getSize().x / 2.0f, m_window.getSize().y / 2.0f);
@@ -246,6 +477,7 @@ void Game::playerDied(float distance)
 {
     std::cout << "Player died. Distance: " << distance << std::endl;
     m_currentState = GameState::GameOver;
+    m_presentRequested = true;
     if (!m_newlyCollectedScrolls.empty())
     {
         // std::cout << "died, preparing to show scroll./ Game.cpp" << std::endl;
@@ -273,10 +505,8 @@ void Game::checkWinCondition(float distance)
             std::cout << "Win condition met!" << std::endl;
             m_currentState = GameState::GameWon;
             m_gameWonMessageDisplayed = true;
-            if (m_currentScene && m_currentScene->getMusic())
-            { // stop game music
-                m_currentScene->getMusic()->stop();
-            }
+            m_presentRequested = true;
+            m_musicService.fadeOut(sf::seconds(0.5f)); // stop game music
         }
     }
 }
\ No newline at end of file
@@ -6,8 +6,19 @@
 #include <SFML/Audio.hpp>
 #include <string>
 #include <memory>
+#include <algorithm>
 #include <vector>
 #include "../scene/Scene.h"
+#include "../ui/ProfilerOverlay.h"
+#include "FrameArena.h"
+#include "FrameScheduler.h"
+#include "LatencyTracker.h"
+#include "FrameTimeHistogram.h"
+#include "FlightRecorder.h"
+#include "QualityGovernor.h"
+#include "../render/InstrumentedRenderTarget.h"
+#include "../audio/AudioMixer.h"
+#include "../audio/MusicService.h"
 
 namespace sf
 {
@@ -28,6 +39,8 @@ enum class GameState
 
 class Game
 {
+    friend class Benchmark; // drives the loop frame by frame in --bench mode
+
 public:
     Game(unsigned int width, unsigned int height, const std::string &title);
     ~Game();
@@ -35,6 +48,23 @@ public:
     void run();
 
     sf::RenderWindow &getWindow() { return m_window; }
+    Scene *getCurrentScene() { return m_currentScene; }
+    FrameArena &getFrameArena() { return m_frameArena; } // transient per-frame allocations
+    FrameScheduler &getFrameScheduler() { return m_frameScheduler; }
+    LatencyTracker &getLatencyTracker() { return m_latencyTracker; } // key press to display(), F3 overlay
+
+    // a frame longer than this writes hitch_<frame>.txt, 0 = off. frame times go to frame_times.json on exit
+    void setHitchBudgetMs(double ms) { m_flightRecorder.setBudgetMs(ms); }
+
+    // steps optional work down when frames run long, scenes read getSettings() in onQualityChanged()
+    QualityGovernor &getQualityGovernor() { return m_quality; }
+    void setQualityLevel(int level); // pins it, --quality N
+
+    // draws, vertices and state changes per layer of the last rendered frame
+    const RenderStats &getRenderStats() const { return m_renderStats; }
+    AudioMixer &getAudioMixer() { return m_audioMixer; } // sound effects, shared by all scenes
+    MusicService &getMusicService() { return m_musicService; }
+    void setVerticalSyncEnabled(bool enabled) { m_window.setVerticalSyncEnabled(enabled); }
     void changeScene(GameState newState);
 
     float getMasterVolume() const { return m_masterVolume; }
@@ -42,6 +72,25 @@ public:
 
     GameState getCurrentState() const { return m_currentState; }
 
+    // .dpkl course for GameScene, empty = procedural. set before the first run
+    void setLevelPath(const std::string &path) { m_levelPath = path; }
+    const std::string &getLevelPath() const { return m_levelPath; }
+
+    // debug: a death freezes GameScene on that frame instead of ending the run, R rewinds from there
+    void setRewindDeaths(bool enabled) { m_rewindDeaths = enabled; }
+    bool getRewindDeaths() const { return m_rewindDeaths; }
+
+    // GameScene draws the world below the HUD at this fraction of the window resolution and upscales it,
+    // the quality level can lower it further
+    static constexpr float MIN_RENDER_SCALE = 0.5f;
+    void setRenderScale(float scale) { m_renderScale = std::max(MIN_RENDER_SCALE, std::min(scale, 1.f)); }
+    float getRenderScale() const { return m_renderScale; }
+
+    // frames GameScene simulates past the real state before presenting, hides that much input latency
+    static constexpr int MAX_RUN_AHEAD_FRAMES = 3;
+    void setRunAheadFrames(int frames) { m_runAheadFrames = std::max(0, std::min(frames, MAX_RUN_AHEAD_FRAMES)); }
+    int getRunAheadFrames() const { return m_runAheadFrames; }
+
     // scroll management
     void collectScroll(int scrollId);
     bool isScrollCollected(int scrollId) const;
@@ -55,15 +104,37 @@ public:
 
 private:
     void processEvents();
+    void handleEvent(sf::Event &event);
+    void waitForEvent();
+    void onFocusChanged();
+    bool isIdle() const; // nothing on screen would change until the next event
     void update(sf::Time deltaTime);
     void render();
     void loadAssets(); // load common assets or trigger scene asset loading
+    void writeHitchReport();
+    void applyQuality();
 
     sf::RenderWindow m_window;
-    std::unique_ptr<Scene> m_currentScene;
+    FrameArena m_frameArena;
+    FrameScheduler m_frameScheduler;
+    LatencyTracker m_latencyTracker;
+    FrameTimeHistogram m_frameTimes; // whole session
+    FlightRecorder m_flightRecorder; // last ~2 s
+    QualityGovernor m_quality;
+    RenderStats m_renderStats;
+    AudioMixer m_audioMixer;
+    MusicService m_musicService;
+    bool m_musicPausedForFocus = false;
+    std::unique_ptr<MenuScene> m_menuScene; // pooled for the whole session
+    std::unique_ptr<GameScene> m_gameScene;
+    Scene *m_currentScene = nullptr;
     GameState m_currentState;
 
     float m_masterVolume = 50.0f; // default vol
+    std::string m_levelPath;
+    bool m_rewindDeaths = false;
+    int m_runAheadFrames = 0;
+    float m_renderScale = 1.f;
 
     // scroll data
     const int m_totalScrolls = 5;
@@ -81,6 +152,9 @@ private:
 
     std::vector<int> m_newlyCollectedScrolls;
 
+    ProfilerOverlay m_profilerOverlay; // F3
+    bool m_presentRequested = false;   // draw one frame even if the scene is idle
+
 public:
     bool m_exitGame = false;
 };
@@ -0,0 +1,90 @@
+// src/core/LatencyTracker.cpp
+#include "LatencyTracker.h"
+#include <algorithm>
+#include <cmath>
+
+void LatencyTracker::onInput(Clock::time_point when)
+{
+    if (m_pendingCount == MAX_PENDING)
+    {
+        // nothing has been presented for a long time (paused, idle screen), forget the oldest
+        m_pendingFirst = (m_pendingFirst + 1) % MAX_PENDING;
+        --m_pendingCount;
+        ++m_dropped;
+    }
+    Pending &pending = m_pending[(m_pendingFirst + m_pendingCount) % MAX_PENDING];
+    pending.when = when;
+    pending.tick = 0;
+    ++m_pendingCount;
+}
+
+void LatencyTracker::onSimulationTick()
+{
+    ++m_tick;
+    // untagged ones are always the newest, walk back until a tagged one
+    for (std::size_t i = m_pendingCount; i-- > 0;)
+    {
+        Pending &pending = m_pending[(m_pendingFirst + i) % MAX_PENDING];
+        if (pending.tick != 0)
+        {
+            break;
+        }
+        pending.tick = m_tick;
+    }
+}
+
+void LatencyTracker::onPresent(Clock::time_point when)
+{
+    // every frame shows the newest tick, so all consumed inputs are on screen now
+    while (m_pendingCount > 0)
+    {
+        const Pending &pending = m_pending[m_pendingFirst];
+        if (pending.tick == 0)
+        {
+            break;
+        }
+        std::int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(when - pending.when).count();
+        us = std::max<std::int64_t>(0, us);
+        std::size_t bucket = std::min<std::size_t>(static_cast<std::size_t>(us / BUCKET_US), BUCKET_COUNT - 1);
+        ++m_buckets[bucket];
+        ++m_samples;
+        m_maxUs = std::max(m_maxUs, us);
+
+        m_pendingFirst = (m_pendingFirst + 1) % MAX_PENDING;
+        --m_pendingCount;
+    }
+}
+
+void LatencyTracker::reset()
+{
+    m_pendingFirst = 0;
+    m_pendingCount = 0;
+    m_buckets.fill(0);
+    m_samples = 0;
+    m_dropped = 0;
+    m_maxUs = 0;
+}
+
+double LatencyTracker::getPercentileMs(double p) const
+{
+    if (m_samples == 0)
+    {
+        return 0.0;
+    }
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * m_samples));
+    rank = std::max<std::size_t>(1, std::min(rank, m_samples));
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            if (i == BUCKET_COUNT - 1)
+            {
+                return getMaxMs(); // the overflow bucket has no upper edge
+            }
+            return static_cast<double>((i + 1) * BUCKET_US) / 1000.0;
+        }
+    }
+    return getMaxMs();
+}
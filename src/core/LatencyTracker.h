@@ -0,0 +1,54 @@
+// src/core/LatencyTracker.h
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// input-to-photon latency: key events are stamped when Game polls them, tagged with the first
+// simulation tick that runs after them, and measured when the frame showing that tick returns from display()
+// the histogram has fixed buckets so recording never allocates
+class LatencyTracker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t MAX_PENDING = 64;      // keys waiting for a tick or a present, the oldest are dropped
+    static constexpr std::int64_t BUCKET_US = 100;
+    static constexpr std::size_t BUCKET_COUNT = 2000;   // up to 200 ms, anything slower lands in the last bucket
+
+    void onInput(Clock::time_point when);
+    // a simulation tick is about to run, every untagged input is consumed by it
+    void onSimulationTick();
+    // display() returned for the newest tick
+    void onPresent(Clock::time_point when);
+
+    void reset();
+
+    std::size_t getSampleCount() const { return m_samples; }
+    std::size_t getDroppedCount() const { return m_dropped; }
+    double getMaxMs() const { return m_maxUs / 1000.0; }
+    // nearest rank over the buckets, upper edge of the bucket it falls in
+    double getPercentileMs(double p) const;
+
+private:
+    struct Pending
+    {
+        Clock::time_point when;
+        std::uint64_t tick = 0; // 0 = not consumed yet
+    };
+
+    std::array<Pending, MAX_PENDING> m_pending{};
+    std::size_t m_pendingFirst = 0;
+    std::size_t m_pendingCount = 0;
+    std::uint64_t m_tick = 0;
+
+    std::array<std::uint32_t, BUCKET_COUNT> m_buckets{};
+    std::size_t m_samples = 0;
+    std::size_t m_dropped = 0;
+    std::int64_t m_maxUs = 0;
+};
+
+#endif // LATENCYTRACKER_H
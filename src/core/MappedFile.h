@@ -0,0 +1,38 @@
+// src/core/MappedFile.h
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// read-only memory map of a whole file, pages come in from disk on first touch
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &filepath);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const std::uint8_t *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    // hint that [offset, offset + length) is needed soon, the OS reads it ahead in the background
+    void prefetch(std::size_t offset, std::size_t length) const;
+
+private:
+    const std::uint8_t *m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
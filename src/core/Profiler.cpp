@@ -0,0 +1,137 @@
+// src/core/Profiler.cpp
+#include "Profiler.h"
+#include <cstring>
+
+namespace
+{
+    // only the thread driving beginFrame/endFrame is profiled
+    thread_local bool t_isProfiledThread = false;
+}
+
+void Profiler::beginFrame()
+{
+    t_isProfiledThread = true;
+    m_inFrame = true;
+    m_depth = 0;
+    m_frameAllocations = 0;
+    m_frameBytes = 0;
+    for (std::size_t i = 0; i < m_scopeCount; ++i)
+    {
+        // keep the slots so scope order stays stable between frames
+        m_current[i].timeMs = 0.0;
+        m_current[i].calls = 0;
+        m_current[i].allocations = 0;
+        m_current[i].bytes = 0;
+    }
+    m_frameStart = Clock::now();
+}
+
+void Profiler::endFrame()
+{
+    while (m_depth > 0)
+    {
+        popScope();
+    }
+    m_lastFrameMs = std::chrono::duration<double, std::milli>(Clock::now() - m_frameStart).count();
+    m_lastFrame = m_current;
+    m_lastScopeCount = m_scopeCount;
+    m_lastFrameAllocations = m_frameAllocations;
+    m_lastFrameBytes = m_frameBytes;
+    m_inFrame = false;
+    ++m_frameIndex;
+}
+
+double Profiler::getScopeTimeMs(const char *name) const
+{
+    for (std::size_t i = 0; i < m_lastScopeCount; ++i)
+    {
+        if (std::strcmp(m_lastFrame[i].name, name) == 0)
+        {
+            return m_lastFrame[i].timeMs;
+        }
+    }
+    return 0.0;
+}
+
+int Profiler::findOrAddScope(const char *name)
+{
+    for (std::size_t i = 0; i < m_scopeCount; ++i)
+    {
+        if (m_current[i].name == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    if (m_scopeCount >= MAX_SCOPES)
+    {
+        return -1;
+    }
+    m_current[m_scopeCount] = ProfileScopeStats();
+    m_current[m_scopeCount].name = name;
+    return static_cast<int>(m_scopeCount++);
+}
+
+void Profiler::pushScope(const char *name)
+{
+    if (!m_inFrame || !t_isProfiledThread)
+    {
+        return;
+    }
+    if (m_depth >= MAX_DEPTH)
+    {
+        ++m_depth; // still balanced by popScope
+        return;
+    }
+    int index = findOrAddScope(name);
+    m_stack[m_depth] = index;
+    m_stackStart[m_depth] = Clock::now();
+    if (index >= 0)
+    {
+        ++m_current[index].calls;
+    }
+    ++m_depth;
+}
+
+void Profiler::popScope()
+{
+    if (!m_inFrame || !t_isProfiledThread || m_depth == 0)
+    {
+        return;
+    }
+    --m_depth;
+    if (m_depth >= MAX_DEPTH)
+    {
+        return;
+    }
+    int index = m_stack[m_depth];
+    if (index >= 0)
+    {
+        m_current[index].timeMs += std::chrono::duration<double, std::milli>(Clock::now() - m_stackStart[m_depth]).count();
+    }
+}
+
+void Profiler::recordAllocation(std::size_t size)
+{
+    if (!t_isProfiledThread)
+    {
+        return;
+    }
+    Profiler &profiler = getInstance();
+    if (!profiler.m_inFrame)
+    {
+        return;
+    }
+    ++profiler.m_frameAllocations;
+    profiler.m_frameBytes += size;
+
+    std::size_t depth = profiler.m_depth < MAX_DEPTH ? profiler.m_depth : MAX_DEPTH;
+    if (depth > 0)
+    {
+        int index = profiler.m_stack[depth - 1];
+        if (index >= 0)
+        {
+            ++profiler.m_current[index].allocations;
+            profiler.m_current[index].bytes += size;
+        }
+    }
+}
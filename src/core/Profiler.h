@@ -0,0 +1,95 @@
+// src/core/Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// per-frame scope timings for the main thread, shown by the F3 overlay and the benchmark report
+// scopes are keyed by their name pointer, so pass string literals
+
+struct ProfileScopeStats
+{
+    const char *name = nullptr;
+    double timeMs = 0.0; // inclusive of nested scopes
+    int calls = 0;
+    std::size_t allocations = 0; // exclusive, the innermost scope gets the allocation
+    std::size_t bytes = 0;
+};
+
+class Profiler
+{
+public:
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    static Profiler &getInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    void beginFrame();
+    void endFrame();
+
+    void pushScope(const char *name);
+    void popScope();
+
+    // called from the operator new hook, must not allocate
+    static void recordAllocation(std::size_t size);
+
+    // last completed frame
+    std::size_t getScopeCount() const { return m_lastScopeCount; }
+    const ProfileScopeStats &getScope(std::size_t index) const { return m_lastFrame[index]; }
+    double getFrameTimeMs() const { return m_lastFrameMs; }
+    std::size_t getFrameAllocations() const { return m_lastFrameAllocations; }
+    std::size_t getFrameBytes() const { return m_lastFrameBytes; }
+    unsigned long long getFrameIndex() const { return m_frameIndex; }
+    // by name rather than pointer, for scopes declared in another file. 0 if it didn't run
+    double getScopeTimeMs(const char *name) const;
+
+    static constexpr std::size_t MAX_SCOPES = 48;
+    static constexpr std::size_t MAX_DEPTH = 16;
+
+private:
+    Profiler() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    int findOrAddScope(const char *name);
+
+    std::array<ProfileScopeStats, MAX_SCOPES> m_current{};
+    std::array<ProfileScopeStats, MAX_SCOPES> m_lastFrame{};
+    std::size_t m_scopeCount = 0;
+    std::size_t m_lastScopeCount = 0;
+
+    std::array<int, MAX_DEPTH> m_stack{};
+    std::array<Clock::time_point, MAX_DEPTH> m_stackStart{};
+    std::size_t m_depth = 0;
+
+    Clock::time_point m_frameStart;
+    bool m_inFrame = false;
+    double m_lastFrameMs = 0.0;
+    std::size_t m_frameAllocations = 0;
+    std::size_t m_frameBytes = 0;
+    std::size_t m_lastFrameAllocations = 0;
+    std::size_t m_lastFrameBytes = 0;
+    unsigned long long m_frameIndex = 0;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name) { Profiler::getInstance().pushScope(name); }
+    ~ProfileScope() { Profiler::getInstance().popScope(); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // PROFILER_H
@@ -0,0 +1,82 @@
+// src/core/QualityGovernor.cpp
+#include "QualityGovernor.h"
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    const std::array<QualitySettings, QualityGovernor::LEVEL_COUNT> LEVELS = {{
+        {"high", 1.f, 1.f, 1, 32, 1.f},
+        {"medium", 0.6f, 0.6f, 2, 24, 0.85f},
+        {"low", 0.35f, 0.3f, 2, 16, 0.7f},
+        {"lowest", 0.15f, 0.1f, 4, 8, 0.5f},
+    }};
+}
+
+const QualitySettings &QualityGovernor::getLevelSettings(int level)
+{
+    return LEVELS[std::max(0, std::min(level, LEVEL_COUNT - 1))];
+}
+
+void QualityGovernor::setLevel(int level)
+{
+    m_level = std::max(0, std::min(level, LEVEL_COUNT - 1));
+    resetWindow();
+}
+
+bool QualityGovernor::onFrame(double frameMs, double presentMs)
+{
+    if (m_skipFrame)
+    {
+        m_skipFrame = false;
+        resetWindow();
+        return false;
+    }
+    double workMs = std::max(0.0, frameMs - presentMs);
+    m_sum += workMs - (m_count == WINDOW_FRAMES ? m_window[m_next] : 0.0);
+    m_window[m_next] = workMs;
+    m_next = (m_next + 1) % WINDOW_FRAMES;
+    m_count = std::min(m_count + 1, WINDOW_FRAMES);
+
+    if (!m_automatic || m_budgetMs <= 0.0 || m_count < WINDOW_FRAMES)
+    {
+        return false;
+    }
+    double rollingMs = getRollingMs();
+    if (rollingMs > m_budgetMs * DOWN_FRACTION)
+    {
+        m_headroomFrames = 0;
+        if (m_level + 1 < LEVEL_COUNT)
+        {
+            changeLevel(m_level + 1, rollingMs);
+            return true;
+        }
+        return false;
+    }
+    m_headroomFrames = rollingMs < m_budgetMs * UP_FRACTION ? m_headroomFrames + 1 : 0;
+    if (m_level > 0 && m_headroomFrames >= UP_HOLD_FRAMES)
+    {
+        changeLevel(m_level - 1, rollingMs);
+        return true;
+    }
+    return false;
+}
+
+void QualityGovernor::changeLevel(int level, double rollingMs)
+{
+    m_lastStep = level > m_level ? 1 : -1;
+    m_lastStepMs = rollingMs;
+    ++m_changeCount;
+    m_level = level;
+    std::cout << "Quality: " << getSettings().name << " (rolling " << rollingMs << " ms of " << m_budgetMs << " ms)" << std::endl;
+    resetWindow();
+}
+
+void QualityGovernor::resetWindow()
+{
+    // the old frames were measured at the old level
+    m_count = 0;
+    m_next = 0;
+    m_sum = 0.0;
+    m_headroomFrames = 0;
+}
@@ -0,0 +1,76 @@
+// src/core/QualityGovernor.h
+#ifndef QUALITYGOVERNOR_H
+#define QUALITYGOVERNOR_H
+
+#include <array>
+#include <cstddef>
+
+// what each quality level keeps of the optional work, level 0 is everything
+struct QualitySettings
+{
+    const char *name;
+    float bFieldDensity;            // scales GameScene::B_FIELD_DENSITY_SCALE_FACTOR
+    float particles;                // scales particle emission
+    unsigned int backgroundDivisor; // background texture at 1/n resolution
+    std::size_t audioVoices;        // AudioMixer voice limit
+    float renderScale;              // scales Game::getRenderScale(), the world's internal resolution
+};
+
+// sheds optional work when frames run long instead of letting them stutter.
+// it watches the rolling mean of the frame's CPU time (the frame minus the time blocked in display(),
+// which with vsync is just waiting), steps down a level when that passes DOWN_FRACTION of the frame
+// budget and back up only after UP_HOLD_FRAMES in a row below UP_FRACTION, so it doesn't flap.
+// the window starts over after every change, so a level is judged on its own frames
+class QualityGovernor
+{
+public:
+    static constexpr int LEVEL_COUNT = 4;
+    static constexpr std::size_t WINDOW_FRAMES = 30;
+    static constexpr double DOWN_FRACTION = 0.9;
+    static constexpr double UP_FRACTION = 0.6;
+    static constexpr int UP_HOLD_FRAMES = 180; // ~3 s of headroom before trying a level up
+
+    static const QualitySettings &getLevelSettings(int level);
+
+    void setBudgetMs(double ms) { m_budgetMs = ms; }
+    double getBudgetMs() const { return m_budgetMs; }
+
+    // false pins the current level, --quality N
+    void setAutomatic(bool automatic) { m_automatic = automatic; }
+    bool isAutomatic() const { return m_automatic; }
+    void setLevel(int level);
+
+    // one finished frame, true if the level changed
+    bool onFrame(double frameMs, double presentMs);
+    // loading a scene stalls the frame it happens in, that one says nothing about the steady state
+    void onSceneChange() { m_skipFrame = true; }
+
+    int getLevel() const { return m_level; }
+    const QualitySettings &getSettings() const { return getLevelSettings(m_level); }
+    double getRollingMs() const { return m_count > 0 ? m_sum / m_count : 0.0; }
+    std::size_t getChangeCount() const { return m_changeCount; }
+    // +1 down a level, -1 up, 0 none yet
+    int getLastStep() const { return m_lastStep; }
+    double getLastStepMs() const { return m_lastStepMs; } // rolling mean that triggered it
+
+private:
+    void changeLevel(int level, double rollingMs);
+    void resetWindow();
+
+    double m_budgetMs = 1000.0 / 60.0;
+    bool m_automatic = true;
+    int m_level = 0;
+
+    std::array<double, WINDOW_FRAMES> m_window{};
+    std::size_t m_next = 0;
+    std::size_t m_count = 0;
+    double m_sum = 0.0;
+    int m_headroomFrames = 0;
+    bool m_skipFrame = false;
+
+    std::size_t m_changeCount = 0;
+    int m_lastStep = 0;
+    double m_lastStepMs = 0.0;
+};
+
+#endif // QUALITYGOVERNOR_H
@@ -0,0 +1,283 @@
+// src/core/RewindBuffer.h
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// history of a trivially copyable snapshot type in a fixed memory budget, oldest first
+// each push is stored as the XOR against the previous one with runs of unchanged words skipped,
+// every keyframeInterval pushes the base is all zeroes instead so a restore decodes at most that many records.
+// when the budget or record count runs out the oldest keyframe and its deltas are dropped together
+// everything is allocated up front, push and restore never allocate
+template <typename Snapshot>
+class RewindBuffer
+{
+    static_assert(std::is_trivially_copyable<Snapshot>::value, "snapshots are diffed as raw words");
+    static_assert(sizeof(Snapshot) % sizeof(std::uint32_t) == 0, "pad the snapshot to whole words");
+
+public:
+    static constexpr std::size_t WORDS = sizeof(Snapshot) / sizeof(std::uint32_t);
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    static_assert(WORDS <= 0xFFFF, "run lengths are 16 bit");
+
+    RewindBuffer(std::size_t budgetBytes, std::size_t maxRecords, std::size_t keyframeInterval)
+        : m_data(budgetBytes / sizeof(std::uint32_t)), m_records(maxRecords), m_keyframeInterval(keyframeInterval),
+          m_last(WORDS, 0), m_current(WORDS, 0), m_encoded(WORDS * 2)
+    {
+    }
+
+    void clear()
+    {
+        m_first = 0;
+        m_count = 0;
+        m_writePos = 0;
+        m_sinceKeyframe = 0;
+    }
+
+    std::size_t size() const { return m_count; }
+    std::uint64_t getStamp(std::size_t index) const { return record(index).stamp; }
+    std::size_t getUsedBytes() const
+    {
+        std::size_t words = 0;
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            words += record(i).length;
+        }
+        return words * sizeof(std::uint32_t);
+    }
+
+    // stamps must not go backwards, e.g. simulation time
+    void push(const Snapshot &snapshot, std::uint64_t stamp)
+    {
+        std::uint32_t *current = m_current.data();
+        std::memcpy(current, &snapshot, sizeof(Snapshot));
+
+        bool keyframe = m_count == 0 || m_sinceKeyframe + 1 >= m_keyframeInterval;
+        std::size_t length = encode(current, keyframe);
+        std::size_t start = 0;
+        while (!reserve(length, start))
+        {
+            evictGroup();
+            if (!keyframe && m_count == 0)
+            {
+                // the delta's base was just evicted
+                keyframe = true;
+                length = encode(current, true);
+            }
+        }
+        if (length > m_data.size())
+        {
+            clear(); // can't hold even one keyframe
+            return;
+        }
+
+        Record &rec = m_records[(m_first + m_count) % m_records.size()];
+        rec.start = start;
+        rec.length = static_cast<std::uint32_t>(length);
+        rec.keyframe = keyframe;
+        rec.stamp = stamp;
+        std::copy(m_encoded.begin(), m_encoded.begin() + length, m_data.begin() + start);
+        m_writePos = start + length;
+        ++m_count;
+        m_sinceKeyframe = keyframe ? 0 : m_sinceKeyframe + 1;
+        m_last.swap(m_current);
+    }
+
+    // newest record at or before stamp, NONE if the history starts later
+    std::size_t findAtOrBefore(std::uint64_t stamp) const
+    {
+        if (m_count == 0 || record(0).stamp > stamp)
+        {
+            return NONE;
+        }
+        std::size_t lo = 0;
+        std::size_t hi = m_count - 1;
+        while (lo < hi)
+        {
+            std::size_t mid = (lo + hi + 1) / 2;
+            if (record(mid).stamp <= stamp)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    // decodes record index (0 = oldest) from its keyframe, at most keyframeInterval records
+    void restore(std::size_t index, Snapshot &out)
+    {
+        decodeInto(index, m_current.data());
+        std::memcpy(static_cast<void *>(&out), m_current.data(), sizeof(Snapshot)); // member initializers only, still trivially copyable
+    }
+
+    // forgets everything after index, the next push continues from it
+    void truncateAfter(std::size_t index)
+    {
+        if (index >= m_count)
+        {
+            return;
+        }
+        decodeInto(index, m_last.data());
+        m_count = index + 1;
+        const Record &rec = record(index);
+        m_writePos = rec.start + rec.length;
+        m_sinceKeyframe = 0;
+        while (!record(index - m_sinceKeyframe).keyframe)
+        {
+            ++m_sinceKeyframe;
+        }
+    }
+
+    // drops whole keyframe groups that end before stamp, keeps the one that covers it
+    void dropBefore(std::uint64_t stamp)
+    {
+        while (m_count > 1)
+        {
+            std::size_t next = 1;
+            while (next < m_count && !record(next).keyframe)
+            {
+                ++next;
+            }
+            if (next == m_count || record(next).stamp > stamp)
+            {
+                return;
+            }
+            evictGroup();
+        }
+    }
+
+private:
+    struct Record
+    {
+        std::size_t start = 0;
+        std::uint32_t length = 0;
+        bool keyframe = false;
+        std::uint64_t stamp = 0;
+    };
+
+    const Record &record(std::size_t index) const { return m_records[(m_first + index) % m_records.size()]; }
+
+    void decodeInto(std::size_t index, std::uint32_t *words) const
+    {
+        std::size_t key = index;
+        while (!record(key).keyframe)
+        {
+            --key;
+        }
+        std::fill(words, words + WORDS, 0u);
+        for (std::size_t i = key; i <= index; ++i)
+        {
+            decode(record(i), words);
+        }
+    }
+
+    // [header: skip << 16 | literals][literals...] repeated, XOR against m_last or zero
+    std::size_t encode(const std::uint32_t *current, bool keyframe)
+    {
+        std::size_t out = 0;
+        std::size_t i = 0;
+        while (i < WORDS)
+        {
+            std::size_t skip = 0;
+            while (i < WORDS && (current[i] ^ (keyframe ? 0u : m_last[i])) == 0)
+            {
+                ++skip;
+                ++i;
+            }
+            if (i == WORDS)
+            {
+                break;
+            }
+            std::size_t header = out++;
+            std::size_t literals = 0;
+            // a single unchanged word between changes is cheaper inline than a new header
+            while (i < WORDS && (literals == 0 || (current[i] ^ (keyframe ? 0u : m_last[i])) != 0 ||
+                                 (i + 1 < WORDS && (current[i + 1] ^ (keyframe ? 0u : m_last[i + 1])) != 0)))
+            {
+                m_encoded[out++] = current[i] ^ (keyframe ? 0u : m_last[i]);
+                ++literals;
+                ++i;
+            }
+            m_encoded[header] = static_cast<std::uint32_t>(skip << 16 | literals);
+        }
+        return out;
+    }
+
+    void decode(const Record &rec, std::uint32_t *words) const
+    {
+        const std::uint32_t *in = m_data.data() + rec.start;
+        const std::uint32_t *end = in + rec.length;
+        std::size_t pos = 0;
+        while (in < end)
+        {
+            std::uint32_t header = *in++;
+            pos += header >> 16;
+            for (std::uint32_t n = header & 0xFFFF; n > 0; --n)
+            {
+                words[pos++] ^= *in++;
+            }
+        }
+    }
+
+    // finds a contiguous gap of length words after the newest record, false if the oldest is in the way
+    bool reserve(std::size_t length, std::size_t &start) const
+    {
+        if (m_count == 0)
+        {
+            start = 0;
+            return true;
+        }
+        if (m_count == m_records.size())
+        {
+            return false;
+        }
+        std::size_t oldest = record(0).start;
+        if (m_writePos > oldest)
+        {
+            // not wrapped: room at the end, otherwise wrap to the front and leave the tail unused
+            if (length <= m_data.size() - m_writePos)
+            {
+                start = m_writePos;
+                return true;
+            }
+            if (length <= oldest)
+            {
+                start = 0;
+                return true;
+            }
+            return false;
+        }
+        if (length <= oldest - m_writePos)
+        {
+            start = m_writePos;
+            return true;
+        }
+        return false;
+    }
+
+    void evictGroup()
+    {
+        do
+        {
+            m_first = (m_first + 1) % m_records.size();
+            --m_count;
+        } while (m_count > 0 && !record(0).keyframe);
+    }
+
+    std::vector<std::uint32_t> m_data;
+    std::vector<Record> m_records;
+    std::size_t m_keyframeInterval;
+    std::size_t m_first = 0;
+    std::size_t m_count = 0;
+    std::size_t m_writePos = 0;
+    std::size_t m_sinceKeyframe = 0;
+    std::vector<std::uint32_t> m_last;    // previous push, the delta base
+    std::vector<std::uint32_t> m_current; // scratch for the snapshot being pushed or restored
+    std::vector<std::uint32_t> m_encoded; // worst case every other word changed
+};
+
+#endif // REWINDBUFFER_H
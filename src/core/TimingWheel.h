@@ -0,0 +1,157 @@
+// src/core/TimingWheel.h
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// hierarchical timing wheel: schedule and fire are O(1) per event, advancing costs one slot per tick
+// LEVELS wheels of SLOTS slots, level n covers SLOTS^(n+1) ticks ahead, later events wait in an overflow list
+// events cascade down a level each time a coarser slot comes due. what a tick means is up to the owner
+template <typename Event>
+class TimingWheel
+{
+public:
+    static constexpr unsigned int SLOT_BITS = 6;
+    static constexpr std::uint64_t SLOTS = 1ULL << SLOT_BITS;
+    static constexpr unsigned int LEVELS = 4; // 64^4 ticks = 4.6 h at 1 ms ticks
+
+    std::uint64_t now() const { return m_now; }
+    std::size_t size() const { return m_size; }
+
+    // fires during the advance that reaches dueTick, or the next advance if it is already due
+    void schedule(std::uint64_t dueTick, const Event &event)
+    {
+        place({dueTick > m_now ? dueTick : m_now + 1, event});
+        ++m_size;
+    }
+    void scheduleAfter(std::uint64_t ticks, const Event &event) { schedule(m_now + (ticks > 0 ? ticks : 1), event); }
+
+    // drops everything and restarts at tick now, slot capacity is kept
+    void clear(std::uint64_t now = 0)
+    {
+        for (auto &level : m_levels)
+        {
+            for (auto &slot : level)
+            {
+                slot.clear();
+            }
+        }
+        m_overflow.clear();
+        m_now = now;
+        m_size = 0;
+    }
+
+    // visits every pending event as f(dueTick, event), in no particular order
+    template <typename F>
+    void forEach(F &&f) const
+    {
+        for (const auto &level : m_levels)
+        {
+            for (const auto &slot : level)
+            {
+                for (const Entry &entry : slot)
+                {
+                    f(entry.due, entry.event);
+                }
+            }
+        }
+        for (const Entry &entry : m_overflow)
+        {
+            f(entry.due, entry.event);
+        }
+    }
+
+    // runs fire(event) for everything due up to and including targetTick, in tick order
+    // fire may schedule more events, ones due within the range still fire in this call
+    template <typename Fire>
+    void advance(std::uint64_t targetTick, Fire &&fire)
+    {
+        while (m_now < targetTick)
+        {
+            ++m_now;
+            if ((m_now & (SLOTS - 1)) == 0)
+            {
+                cascade();
+            }
+            std::vector<Entry> &slot = m_levels[0][m_now & (SLOTS - 1)];
+            if (slot.empty())
+            {
+                continue;
+            }
+            // swap out so fire() can schedule into this same slot
+            m_firing.swap(slot);
+            for (const Entry &entry : m_firing)
+            {
+                --m_size;
+                fire(entry.event);
+            }
+            m_firing.clear();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t due;
+        Event event;
+    };
+
+    void place(const Entry &entry)
+    {
+        std::uint64_t delta = entry.due - m_now;
+        for (unsigned int level = 0; level < LEVELS; ++level)
+        {
+            if (delta < (SLOTS << (SLOT_BITS * level)))
+            {
+                m_levels[level][(entry.due >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(entry);
+                return;
+            }
+        }
+        m_overflow.push_back(entry);
+    }
+
+    // m_now just wrapped level 0: pull the coarser slots that came due down, top level first
+    // so anything they drop into a lower level's current slot is cascaded again
+    void cascade()
+    {
+        unsigned int top = 1;
+        while (top < LEVELS && ((m_now >> (SLOT_BITS * top)) & (SLOTS - 1)) == 0)
+        {
+            ++top;
+        }
+        if (top == LEVELS)
+        {
+            redistribute(m_overflow);
+        }
+        for (unsigned int level = top < LEVELS ? top : LEVELS - 1; level >= 1; --level)
+        {
+            redistribute(m_levels[level][(m_now >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+        }
+    }
+
+    void redistribute(std::vector<Entry> &slot)
+    {
+        if (slot.empty())
+        {
+            return;
+        }
+        m_cascading.swap(slot);
+        for (const Entry &entry : m_cascading)
+        {
+            place(entry);
+        }
+        m_cascading.clear();
+    }
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> m_levels;
+    std::vector<Entry> m_overflow;
+    std::vector<Entry> m_firing;
+    std::vector<Entry> m_cascading;
+    std::uint64_t m_now = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // TIMINGWHEEL_H
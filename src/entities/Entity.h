@@ -3,6 +3,7 @@
 #define ENTITY_H
 
 #include <SFML/Graphics.hpp>
+#include "../render/InstrumentedRenderTarget.h"
 
 class Entity
 {
@@ -10,7 +11,7 @@ public:
     virtual ~Entity() = default;
 
     virtual void update(sf::Time deltaTime) = 0;
-    virtual void render(sf::RenderWindow &window) = 0;
+    virtual void render(InstrumentedRenderTarget &target) = 0;
 
     virtual sf::FloatRect getBounds() const = 0;
     virtual sf::Vector2f getPosition() const = 0;
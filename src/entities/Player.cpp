@@ -2,15 +2,17 @@
 #include "Player.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
-Player::Player(sf::Vector2f startPosition, sf::Texture &texture)
+Player::Player(sf::Vector2f startPosition, const sf::Texture &texture, const sf::IntRect &region)
     : m_velocity(0.f, 0.f), m_charge(1.0f), m_dashCharges(MAX_DASH_CHARGES)
 {
     m_sprite.setTexture(texture);
-    // make sure texture is loaded before getting its size
-    if (texture.getSize().x > 0 && texture.getSize().y > 0)
+    m_sprite.setTextureRect(region);
+    // make sure the region is valid before getting its size
+    if (region.width > 0 && region.height > 0)
     {
-        m_sprite.setOrigin(texture.getSize().x / 2.f, texture.getSize().y / 2.f);
+        m_sprite.setOrigin(region.width / 2.f, region.height / 2.f);
         float desiredWidth = 64.f;
         float scale = desiredWidth / m_sprite.getLocalBounds().width;
         m_sprite.setScale(scale, scale);
@@ -31,9 +33,9 @@ void Player::update(sf::Time deltaTime)
     // for animation
 }
 
-void Player::render(sf::RenderWindow &window)
+void Player::render(InstrumentedRenderTarget &target)
 {
-    window.draw(m_sprite);
+    target.draw(m_sprite);
     // std::cout << "player rendering./ Player.cpp" << std::endl;
 }
 
@@ -187,4 +189,9 @@ void Player::resetDashCharges()
 int Player::getDashCharges() const
 {
     return m_dashCharges;
-}
\ No newline at end of file
+}
+
+void Player::setDashCharges(int charges)
+{
+    m_dashCharges = std::max(0, std::min(charges, MAX_DASH_CHARGES));
+}
@@ -8,13 +8,14 @@
 class Player : public Entity
 {
 public:
-    Player(sf::Vector2f startPosition, sf::Texture &texture);
+    Player(sf::Vector2f startPosition, const sf::Texture &texture, const sf::IntRect &region);
 
     void update(sf::Time deltaTime) override; // for internal logic ,physics engine moves it
-    void render(sf::RenderWindow &window) override;
+    void render(InstrumentedRenderTarget &target) override;
 
     sf::FloatRect getBounds() const override;
     sf::Vector2f getPosition() const override;
+    const sf::Sprite &getSprite() const { return m_sprite; } // batched by GameScene
     void setPosition(const sf::Vector2f &pos) override;
 
     void setVelocity(const sf::Vector2f &vel);
@@ -31,6 +32,7 @@ public:
     void dash(const sf::Vector2f &direction);
     void resetDashCharges();
     int getDashCharges() const;
+    void setDashCharges(int charges); // restoring a snapshot
 
 private:
     sf::Sprite m_sprite;
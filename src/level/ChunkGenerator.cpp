@@ -0,0 +1,237 @@
+// src/level/ChunkGenerator.cpp
+#include "ChunkGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace
+{
+    // splitmix64 finalizer, decorrelates neighbouring chunk indices
+    std::uint32_t chunkSeed(std::uint32_t seed, std::uint32_t index)
+    {
+        std::uint64_t z = (static_cast<std::uint64_t>(seed) << 32 | index) + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<std::uint32_t>(z ^ (z >> 31));
+    }
+
+    enum class Formation
+    {
+        Scatter, // independent lasers, the old single-timer behaviour
+        Volley,  // a burst from one edge sweeping across it
+        Wall     // several at once from one edge with a single gap
+    };
+
+    // formations are built AoS, then sorted and split into the chunk's SoA arrays
+    struct LaserList
+    {
+        std::array<LaserSpawn, LevelChunk::MAX_LASERS> spawns{};
+        std::size_t count = 0;
+    };
+
+    void addLaser(LaserList &list, float offset, LaserSide side, float along, float speed)
+    {
+        if (list.count >= LevelChunk::MAX_LASERS)
+        {
+            return;
+        }
+        LaserSpawn &spawn = list.spawns[list.count++];
+        spawn.offset = std::max(0.f, std::min(offset, LevelChunk::WIDTH - 1.f));
+        spawn.side = side;
+        spawn.along = std::max(0.f, std::min(along, 1.f));
+        spawn.speed = speed;
+    }
+}
+
+ChunkGenerator::~ChunkGenerator()
+{
+    stop();
+}
+
+void ChunkGenerator::start(std::uint32_t seed, std::uint32_t firstIndex)
+{
+    stop();
+    // worker is joined, safe to drain from this thread
+    LevelChunk stale;
+    while (m_ready.pop(stale))
+    {
+    }
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread(&ChunkGenerator::workerLoop, this, seed, firstIndex);
+}
+
+void ChunkGenerator::stop()
+{
+    if (!m_worker.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+bool ChunkGenerator::takeChunk(std::uint32_t index, LevelChunk &chunk)
+{
+    while (m_ready.pop(chunk))
+    {
+        m_wake.notify_one(); // room for one more
+        if (chunk.index == index)
+        {
+            return true;
+        }
+        if (chunk.index > index)
+        {
+            return false; // can't happen after start(), but never hand out the wrong one
+        }
+        // older than index: was late and already generated inline, drop it
+    }
+    return false;
+}
+
+void ChunkGenerator::workerLoop(std::uint32_t seed, std::uint32_t index)
+{
+    while (m_running.load(std::memory_order_acquire))
+    {
+        LevelChunk chunk = generate(seed, index);
+        while (!m_ready.push(chunk))
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            // the timeout covers a notify that lands between the failed push and the wait
+            m_wake.wait_for(lock, std::chrono::milliseconds(50), [this]
+                            { return !m_running.load(std::memory_order_acquire) || m_ready.size() < LOOKAHEAD; });
+            if (!m_running.load(std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+        ++index;
+    }
+}
+
+LevelChunk ChunkGenerator::generate(std::uint32_t seed, std::uint32_t index)
+{
+    std::mt19937 rng(chunkSeed(seed, index));
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    LevelChunk chunk;
+    chunk.index = index;
+
+    // ramps up over the first ~2 minutes
+    float difficulty = std::min(1.f, index / 20.f);
+
+    // field zone, same ranges GameScene::randomizeFields uses
+    chunk.changesFields = index == 0 || rng() % 3 != 0;
+    if (chunk.changesFields)
+    {
+        std::uniform_real_distribution<float> eDist(-50.f, 50.f);
+        std::uniform_real_distribution<float> bDist(-2.f, 2.f);
+        if (rng() % 2 == 0)
+        {
+            chunk.electricField = {eDist(rng), 0.f};
+        }
+        else
+        {
+            chunk.electricField = {0.f, eDist(rng) / 2.f};
+        }
+        chunk.magneticField_Z = bDist(rng);
+    }
+
+    std::uniform_real_distribution<float> speedDist(150.f + difficulty * 50.f, 350.f + difficulty * 100.f);
+    LaserList lasers;
+    if (index == 0)
+    {
+        // a moment to get oriented, like the old first spawn at 2 s
+        addLaser(lasers, 200.f + unit(rng) * 200.f, static_cast<LaserSide>(rng() % 4), unit(rng), speedDist(rng));
+    }
+    else
+    {
+        Formation formation = Formation::Scatter;
+        std::uint32_t roll = rng() % 10;
+        if (index >= 2 && roll < 3)
+        {
+            formation = Formation::Wall;
+        }
+        else if (roll < 6)
+        {
+            formation = Formation::Volley;
+        }
+
+        switch (formation)
+        {
+        case Formation::Scatter:
+        {
+            int count = 2 + static_cast<int>(difficulty * 4.f) + static_cast<int>(rng() % 2);
+            for (int i = 0; i < count; ++i)
+            {
+                addLaser(lasers, unit(rng) * LevelChunk::WIDTH, static_cast<LaserSide>(rng() % 4), unit(rng), speedDist(rng));
+            }
+            break;
+        }
+        case Formation::Volley:
+        {
+            // never from the left, the player can't see it coming
+            LaserSide side = static_cast<LaserSide>(rng() % 2 == 0 ? rng() % 2 : 3);
+            int count = 3 + static_cast<int>(difficulty * 3.f);
+            float start = unit(rng) * LevelChunk::WIDTH * 0.4f;
+            float spacing = 40.f + unit(rng) * 40.f;
+            float from = unit(rng);
+            float to = unit(rng);
+            float speed = speedDist(rng);
+            for (int i = 0; i < count; ++i)
+            {
+                float t = count > 1 ? static_cast<float>(i) / (count - 1) : 0.f;
+                addLaser(lasers, start + i * spacing, side, from + (to - from) * t, speed);
+            }
+            break;
+        }
+        case Formation::Wall:
+        {
+            LaserSide side = static_cast<LaserSide>(rng() % 2 == 0 ? rng() % 2 : 3);
+            int slots = 5 + static_cast<int>(difficulty * 3.f);
+            int gap = 1 + static_cast<int>(rng() % (slots - 2)); // never at the very edge
+            float offset = 100.f + unit(rng) * (LevelChunk::WIDTH - 200.f);
+            float speed = speedDist(rng) * 0.8f; // slower so the gap can be reached
+            for (int i = 0; i < slots; ++i)
+            {
+                if (i != gap)
+                {
+                    addLaser(lasers, offset, side, (i + 0.5f) / slots, speed);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    std::sort(lasers.spawns.begin(), lasers.spawns.begin() + lasers.count,
+              [](const LaserSpawn &a, const LaserSpawn &b)
+              { return a.offset < b.offset; });
+    chunk.laserCount = lasers.count;
+    for (std::size_t i = 0; i < lasers.count; ++i)
+    {
+        chunk.laserOffset[i] = lasers.spawns[i].offset;
+        chunk.laserAlong[i] = lasers.spawns[i].along;
+        chunk.laserSpeed[i] = lasers.spawns[i].speed;
+        chunk.laserSide[i] = static_cast<std::uint8_t>(lasers.spawns[i].side);
+    }
+
+    // roughly the old 8-15 s scroll timer
+    if (index > 0 && rng() % 2 == 0)
+    {
+        chunk.scrollOffset[0] = 100.f + unit(rng) * (LevelChunk::WIDTH - 200.f);
+        chunk.scrollY[0] = unit(rng);
+        chunk.scrollCount = 1;
+    }
+
+    // now and then a scripted wave on top, rolled last so the rest of the chunk is unchanged by it
+    if (index >= 3 && rng() % 4 == 0)
+    {
+        chunk.patternOffset[0] = 50.f + unit(rng) * (LevelChunk::WIDTH - 300.f);
+        chunk.patternId[0] = rng();
+        chunk.patternCount = 1;
+    }
+    return chunk;
+}
@@ -0,0 +1,51 @@
+// src/level/ChunkGenerator.h
+#ifndef CHUNKGENERATOR_H
+#define CHUNKGENERATOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "LevelChunk.h"
+#include "../core/SpscQueue.h"
+
+// produces the course ahead of the player on a worker thread
+// chunk n depends only on (seed, n), so a seed replays the same course
+class ChunkGenerator
+{
+public:
+    ChunkGenerator() = default;
+    ~ChunkGenerator();
+
+    ChunkGenerator(const ChunkGenerator &) = delete;
+    ChunkGenerator &operator=(const ChunkGenerator &) = delete;
+
+    // (re)starts the stream at firstIndex, drops anything generated for the previous seed
+    void start(std::uint32_t seed, std::uint32_t firstIndex = 0);
+    void stop();
+
+    // main thread, the chunk for index. chunks the worker finished too late are dropped on the way,
+    // false if it hasn't caught up yet (generate() it inline then)
+    bool takeChunk(std::uint32_t index, LevelChunk &chunk);
+
+    std::size_t getReadyCount() const { return m_ready.size(); }
+
+    static constexpr std::size_t LOOKAHEAD = 8; // chunks kept ready, ~32 s of course at 150 px/s
+
+    // pure function of (seed, index), the worker calls it for index 0, 1, 2, ...
+    static LevelChunk generate(std::uint32_t seed, std::uint32_t index);
+
+private:
+    void workerLoop(std::uint32_t seed, std::uint32_t index);
+
+    SpscQueue<LevelChunk, LOOKAHEAD> m_ready;
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+
+    // only for parking the worker while the queue is full, chunks never go through the lock
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+};
+
+#endif // CHUNKGENERATOR_H
@@ -0,0 +1,144 @@
+// src/level/LevelChunk.h
+#ifndef LEVELCHUNK_H
+#define LEVELCHUNK_H
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "../physics/PhysicsEngine.h"
+
+enum class LaserSide : std::uint8_t
+{
+    Top,
+    Bottom,
+    Left,
+    Right
+};
+
+struct LaserSpawn
+{
+    float offset = 0.f; // course px into the chunk when it fires
+    LaserSide side = LaserSide::Top;
+    float along = 0.5f; // 0..1 position along the spawn edge
+    float speed = 200.f;
+};
+
+// starts a scripted wave (see PatternScript.h). pattern n plays the n-th pattern of the library, wrapping
+struct PatternTrigger
+{
+    float offset = 0.f;
+    std::uint32_t pattern = 0;
+};
+
+// read-only look at one chunk, wherever it lives (a generated LevelChunk or a mapped level file)
+// hazards and scrolls are SoA and sorted by offset
+struct LevelChunkView
+{
+    std::uint32_t index = 0;
+
+    // field zone, applied when the chunk starts
+    bool changesFields = false;
+    sf::Vector2f electricField;
+    float magneticField_Z = 0.f;
+
+    std::size_t laserCount = 0;
+    const float *laserOffset = nullptr;
+    const float *laserAlong = nullptr;
+    const float *laserSpeed = nullptr;
+    const std::uint8_t *laserSide = nullptr;
+
+    // the id is picked on the main thread, which knows what has been collected
+    std::size_t scrollCount = 0;
+    const float *scrollOffset = nullptr;
+    const float *scrollY = nullptr; // 0..1 of the playable height
+
+    std::size_t patternCount = 0;
+    const float *patternOffset = nullptr;
+    const std::uint32_t *patternId = nullptr;
+
+    // optional fields that vary across the chunk, columns along the course, rows down the screen
+    std::uint32_t gridColumns = 0;
+    std::uint32_t gridRows = 0;
+    const float *gridElectricX = nullptr;
+    const float *gridElectricY = nullptr;
+    const float *gridMagneticZ = nullptr;
+
+    LaserSpawn laser(std::size_t i) const
+    {
+        LaserSpawn spawn;
+        spawn.offset = laserOffset[i];
+        spawn.side = static_cast<LaserSide>(laserSide[i]);
+        spawn.along = laserAlong[i];
+        spawn.speed = laserSpeed[i];
+        return spawn;
+    }
+
+    // u: 0..1 through the chunk, v: 0..1 down the screen. false if the chunk has no grid
+    bool sampleFields(float u, float v, FieldProperties &out) const
+    {
+        if (gridColumns == 0 || gridRows == 0)
+        {
+            return false;
+        }
+        std::uint32_t column = std::min(gridColumns - 1, static_cast<std::uint32_t>(std::max(0.f, u) * gridColumns));
+        std::uint32_t row = std::min(gridRows - 1, static_cast<std::uint32_t>(std::max(0.f, v) * gridRows));
+        std::size_t cell = static_cast<std::size_t>(row) * gridColumns + column;
+        out.electricField = {gridElectricX[cell], gridElectricY[cell]};
+        out.magneticField_Z = gridMagneticZ[cell];
+        return true;
+    }
+};
+
+// one generated slice of the course. plain data with fixed capacity so it crosses threads without allocating
+struct LevelChunk
+{
+    static constexpr float WIDTH = 600.f; // course px, 4 s at the default scroll speed of 150 px/s
+    static constexpr std::size_t MAX_LASERS = 12;
+    static constexpr std::size_t MAX_SCROLLS = 2;
+    static constexpr std::size_t MAX_PATTERNS = 2;
+
+    std::uint32_t index = 0;
+
+    bool changesFields = false;
+    sf::Vector2f electricField;
+    float magneticField_Z = 0.f;
+
+    std::array<float, MAX_LASERS> laserOffset{};
+    std::array<float, MAX_LASERS> laserAlong{};
+    std::array<float, MAX_LASERS> laserSpeed{};
+    std::array<std::uint8_t, MAX_LASERS> laserSide{};
+    std::size_t laserCount = 0;
+
+    std::array<float, MAX_SCROLLS> scrollOffset{};
+    std::array<float, MAX_SCROLLS> scrollY{};
+    std::size_t scrollCount = 0;
+
+    std::array<float, MAX_PATTERNS> patternOffset{};
+    std::array<std::uint32_t, MAX_PATTERNS> patternId{};
+    std::size_t patternCount = 0;
+
+    LevelChunkView view() const
+    {
+        LevelChunkView v;
+        v.index = index;
+        v.changesFields = changesFields;
+        v.electricField = electricField;
+        v.magneticField_Z = magneticField_Z;
+        v.laserCount = laserCount;
+        v.laserOffset = laserOffset.data();
+        v.laserAlong = laserAlong.data();
+        v.laserSpeed = laserSpeed.data();
+        v.laserSide = laserSide.data();
+        v.scrollCount = scrollCount;
+        v.scrollOffset = scrollOffset.data();
+        v.scrollY = scrollY.data();
+        v.patternCount = patternCount;
+        v.patternOffset = patternOffset.data();
+        v.patternId = patternId.data();
+        return v;
+    }
+};
+
+#endif // LEVELCHUNK_H
@@ -0,0 +1,294 @@
+// src/level/LevelFile.cpp
+#include "LevelFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    const char MAGIC[4] = {'D', 'P', 'K', 'L'};
+
+    std::uint64_t align4(std::uint64_t value) { return (value + 3) & ~std::uint64_t(3); }
+
+    std::uint64_t laserBytes(std::uint64_t count) { return align4(count * (3 * sizeof(float) + 1)); }
+    std::uint64_t scrollBytes(std::uint64_t count) { return count * 2 * sizeof(float); }
+    std::uint64_t gridBytes(std::uint64_t cells) { return cells * 3 * sizeof(float); }
+    std::uint64_t patternBytes(std::uint64_t count) { return count * (sizeof(float) + sizeof(std::uint32_t)); }
+
+    // [offset, offset + bytes) inside a record of recordSize, 4-byte aligned
+    bool fits(std::uint64_t offset, std::uint64_t bytes, std::uint64_t recordSize)
+    {
+        return bytes == 0 || (offset % 4 == 0 && offset + bytes <= recordSize);
+    }
+
+    template <typename T>
+    void append(std::vector<std::uint8_t> &out, const T &value)
+    {
+        const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+bool LevelFile::open(const std::string &filepath)
+{
+    close();
+    if (!m_file.open(filepath))
+    {
+        std::cerr << "LevelFile: can't map " << filepath << std::endl;
+        return false;
+    }
+    if (m_file.size() < sizeof(FileHeader))
+    {
+        std::cerr << "LevelFile: " << filepath << " is too small" << std::endl;
+        close();
+        return false;
+    }
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(m_file.data());
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+        header->headerSize != sizeof(FileHeader) || header->chunkWidth != LevelChunk::WIDTH)
+    {
+        std::cerr << "LevelFile: " << filepath << " is not a version " << VERSION << " level" << std::endl;
+        close();
+        return false;
+    }
+    std::uint64_t tableEnd = header->chunkTableOffset + std::uint64_t(header->chunkCount) * sizeof(ChunkEntry);
+    if (header->chunkTableOffset % 4 != 0 || tableEnd > m_file.size())
+    {
+        std::cerr << "LevelFile: " << filepath << " has a truncated chunk table" << std::endl;
+        close();
+        return false;
+    }
+    m_chunkTable = reinterpret_cast<const ChunkEntry *>(m_file.data() + header->chunkTableOffset);
+    m_chunkCount = header->chunkCount;
+    return true;
+}
+
+void LevelFile::close()
+{
+    m_file.close();
+    m_chunkTable = nullptr;
+    m_chunkCount = 0;
+}
+
+bool LevelFile::getChunk(std::size_t index, LevelChunkView &view) const
+{
+    if (!isOpen() || index >= m_chunkCount)
+    {
+        return false;
+    }
+    const ChunkEntry &entry = m_chunkTable[index];
+    if (entry.offset % 4 != 0 || entry.size < sizeof(ChunkRecord) || std::uint64_t(entry.offset) + entry.size > m_file.size())
+    {
+        return false;
+    }
+    const std::uint8_t *base = m_file.data() + entry.offset;
+    const ChunkRecord *record = reinterpret_cast<const ChunkRecord *>(base);
+    std::uint64_t cells = std::uint64_t(record->gridColumns) * record->gridRows;
+    // checked before gridBytes, a huge grid would wrap the byte count and pass fits()
+    if (cells > entry.size / (3 * sizeof(float)) ||
+        !fits(record->lasersOffset, laserBytes(record->laserCount), entry.size) ||
+        !fits(record->scrollsOffset, scrollBytes(record->scrollCount), entry.size) ||
+        !fits(record->gridOffset, gridBytes(cells), entry.size) ||
+        !fits(record->patternsOffset, patternBytes(record->patternCount), entry.size))
+    {
+        return false;
+    }
+    // spawnLaser has no case for anything past Right
+    const std::uint8_t *sides = base + record->lasersOffset + std::uint64_t(record->laserCount) * 3 * sizeof(float);
+    for (std::uint32_t i = 0; i < record->laserCount; ++i)
+    {
+        if (sides[i] > static_cast<std::uint8_t>(LaserSide::Right))
+        {
+            return false;
+        }
+    }
+
+    view = LevelChunkView();
+    view.index = static_cast<std::uint32_t>(index);
+    view.changesFields = (record->flags & FLAG_CHANGES_FIELDS) != 0;
+    view.electricField = {record->electricX, record->electricY};
+    view.magneticField_Z = record->magneticZ;
+
+    const float *lasers = reinterpret_cast<const float *>(base + record->lasersOffset);
+    view.laserCount = record->laserCount;
+    view.laserOffset = lasers;
+    view.laserAlong = lasers + record->laserCount;
+    view.laserSpeed = lasers + record->laserCount * 2;
+    view.laserSide = reinterpret_cast<const std::uint8_t *>(lasers + record->laserCount * 3);
+
+    const float *scrolls = reinterpret_cast<const float *>(base + record->scrollsOffset);
+    view.scrollCount = record->scrollCount;
+    view.scrollOffset = scrolls;
+    view.scrollY = scrolls + record->scrollCount;
+
+    if (cells > 0)
+    {
+        const float *grid = reinterpret_cast<const float *>(base + record->gridOffset);
+        view.gridColumns = record->gridColumns;
+        view.gridRows = record->gridRows;
+        view.gridElectricX = grid;
+        view.gridElectricY = grid + cells;
+        view.gridMagneticZ = grid + cells * 2;
+    }
+
+    const float *patterns = reinterpret_cast<const float *>(base + record->patternsOffset);
+    view.patternCount = record->patternCount;
+    view.patternOffset = patterns;
+    view.patternId = reinterpret_cast<const std::uint32_t *>(patterns + record->patternCount);
+    return true;
+}
+
+void LevelFile::prefetch(std::size_t firstChunk, std::size_t count) const
+{
+    if (!isOpen() || firstChunk >= m_chunkCount)
+    {
+        return;
+    }
+    // records are written in order, so the range is contiguous
+    std::size_t last = std::min(firstChunk + count, m_chunkCount) - 1;
+    std::size_t begin = m_chunkTable[firstChunk].offset;
+    std::size_t end = std::size_t(m_chunkTable[last].offset) + m_chunkTable[last].size;
+    if (end > begin)
+    {
+        m_file.prefetch(begin, end - begin);
+    }
+}
+
+bool LevelFile::write(const std::string &filepath, const std::vector<LevelChunkDesc> &chunks)
+{
+    std::vector<std::uint8_t> out;
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.chunkCount = static_cast<std::uint32_t>(chunks.size());
+    header.chunkWidth = LevelChunk::WIDTH;
+    header.chunkTableOffset = sizeof(FileHeader);
+    append(out, header);
+    out.resize(out.size() + chunks.size() * sizeof(ChunkEntry)); // table, filled in below
+
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        const LevelChunkDesc &desc = chunks[i];
+        std::vector<LaserSpawn> lasers = desc.lasers;
+        std::sort(lasers.begin(), lasers.end(), [](const LaserSpawn &a, const LaserSpawn &b)
+                  { return a.offset < b.offset; });
+        std::vector<sf::Vector2f> scrolls = desc.scrolls;
+        std::sort(scrolls.begin(), scrolls.end(), [](const sf::Vector2f &a, const sf::Vector2f &b)
+                  { return a.x < b.x; });
+        std::vector<PatternTrigger> patterns = desc.patterns;
+        std::sort(patterns.begin(), patterns.end(), [](const PatternTrigger &a, const PatternTrigger &b)
+                  { return a.offset < b.offset; });
+        std::uint64_t cells = std::uint64_t(desc.gridColumns) * desc.gridRows;
+        if (cells != desc.grid.size())
+        {
+            std::cerr << "LevelFile: chunk " << i << " grid is " << desc.grid.size() << " cells, expected " << cells << std::endl;
+            return false;
+        }
+
+        ChunkRecord record{};
+        record.flags = desc.changesFields ? FLAG_CHANGES_FIELDS : 0u;
+        record.electricX = desc.electricField.x;
+        record.electricY = desc.electricField.y;
+        record.magneticZ = desc.magneticField_Z;
+        record.laserCount = static_cast<std::uint32_t>(lasers.size());
+        record.lasersOffset = sizeof(ChunkRecord);
+        record.scrollCount = static_cast<std::uint32_t>(scrolls.size());
+        record.scrollsOffset = static_cast<std::uint32_t>(record.lasersOffset + laserBytes(lasers.size()));
+        record.gridColumns = cells > 0 ? desc.gridColumns : 0;
+        record.gridRows = cells > 0 ? desc.gridRows : 0;
+        record.gridOffset = static_cast<std::uint32_t>(record.scrollsOffset + scrollBytes(scrolls.size()));
+        record.patternCount = static_cast<std::uint32_t>(patterns.size());
+        record.patternsOffset = static_cast<std::uint32_t>(record.gridOffset + gridBytes(cells));
+
+        std::size_t recordStart = out.size();
+        append(out, record);
+        for (const LaserSpawn &laser : lasers)
+        {
+            append(out, laser.offset);
+        }
+        for (const LaserSpawn &laser : lasers)
+        {
+            append(out, laser.along);
+        }
+        for (const LaserSpawn &laser : lasers)
+        {
+            append(out, laser.speed);
+        }
+        for (const LaserSpawn &laser : lasers)
+        {
+            out.push_back(static_cast<std::uint8_t>(laser.side));
+        }
+        out.resize(recordStart + record.scrollsOffset, 0);
+        for (const sf::Vector2f &scroll : scrolls)
+        {
+            append(out, scroll.x);
+        }
+        for (const sf::Vector2f &scroll : scrolls)
+        {
+            append(out, scroll.y);
+        }
+        for (const FieldProperties &cell : desc.grid)
+        {
+            append(out, cell.electricField.x);
+        }
+        for (const FieldProperties &cell : desc.grid)
+        {
+            append(out, cell.electricField.y);
+        }
+        for (const FieldProperties &cell : desc.grid)
+        {
+            append(out, cell.magneticField_Z);
+        }
+        for (const PatternTrigger &trigger : patterns)
+        {
+            append(out, trigger.offset);
+        }
+        for (const PatternTrigger &trigger : patterns)
+        {
+            append(out, trigger.pattern);
+        }
+
+        ChunkEntry entry{static_cast<std::uint32_t>(recordStart), static_cast<std::uint32_t>(out.size() - recordStart)};
+        std::memcpy(out.data() + sizeof(FileHeader) + i * sizeof(ChunkEntry), &entry, sizeof(entry));
+    }
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size())))
+    {
+        std::cerr << "LevelFile: failed to write " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+LevelChunkDesc LevelFile::describe(const LevelChunkView &chunk)
+{
+    LevelChunkDesc desc;
+    desc.changesFields = chunk.changesFields;
+    desc.electricField = chunk.electricField;
+    desc.magneticField_Z = chunk.magneticField_Z;
+    for (std::size_t i = 0; i < chunk.laserCount; ++i)
+    {
+        desc.lasers.push_back(chunk.laser(i));
+    }
+    for (std::size_t i = 0; i < chunk.scrollCount; ++i)
+    {
+        desc.scrolls.push_back({chunk.scrollOffset[i], chunk.scrollY[i]});
+    }
+    for (std::size_t i = 0; i < chunk.patternCount; ++i)
+    {
+        desc.patterns.push_back({chunk.patternOffset[i], chunk.patternId[i]});
+    }
+    desc.gridColumns = chunk.gridColumns;
+    desc.gridRows = chunk.gridRows;
+    for (std::size_t i = 0; i < std::size_t(chunk.gridColumns) * chunk.gridRows; ++i)
+    {
+        FieldProperties cell;
+        cell.electricField = {chunk.gridElectricX[i], chunk.gridElectricY[i]};
+        cell.magneticField_Z = chunk.gridMagneticZ[i];
+        desc.grid.push_back(cell);
+    }
+    return desc;
+}
@@ -0,0 +1,99 @@
+// src/level/LevelFile.h
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LevelChunk.h"
+#include "../core/MappedFile.h"
+
+// authored course, one entry per LevelChunk::WIDTH slice. only used to write files
+struct LevelChunkDesc
+{
+    bool changesFields = false;
+    sf::Vector2f electricField;
+    float magneticField_Z = 0.f;
+    std::vector<LaserSpawn> lasers;    // any order, sorted on write
+    std::vector<sf::Vector2f> scrolls; // (offset, y 0..1)
+    std::vector<PatternTrigger> patterns; // any order, sorted on write
+    std::uint32_t gridColumns = 0;     // optional field grid, row-major
+    std::uint32_t gridRows = 0;
+    std::vector<FieldProperties> grid;
+};
+
+// designer-made course in a versioned binary file (.dpkl), memory-mapped and read in place
+//
+// layout, little-endian, every section 4-byte aligned:
+//   FileHeader
+//   ChunkEntry[chunkCount]              offset/size of each chunk record from the file start
+//   per chunk: ChunkRecord, then its arrays at offsets relative to the record
+//     lasers   float offset[n], float along[n], float speed[n], uint8 side[n]
+//     scrolls  float offset[n], float y[n]
+//     grid     float ex[c*r], float ey[c*r], float bz[c*r]
+//     patterns float offset[n], uint32 pattern[n]
+//
+// open() only checks the header, so a course of any length opens in constant time.
+// getChunk() bounds-checks one record and fixes up its pointers, there is no parse step
+class LevelFile
+{
+public:
+    static constexpr std::uint16_t VERSION = 2; // 2: pattern triggers
+
+    bool open(const std::string &filepath);
+    void close();
+    bool isOpen() const { return m_chunkTable != nullptr; }
+
+    std::size_t getChunkCount() const { return m_chunkCount; }
+    bool getChunk(std::size_t index, LevelChunkView &view) const;
+
+    // asks the OS to page in the chunks the camera will reach next
+    void prefetch(std::size_t firstChunk, std::size_t count) const;
+
+    static bool write(const std::string &filepath, const std::vector<LevelChunkDesc> &chunks);
+    static LevelChunkDesc describe(const LevelChunkView &chunk); // e.g. to export a generated course
+
+private:
+    struct FileHeader
+    {
+        char magic[4];
+        std::uint16_t version;
+        std::uint16_t headerSize;
+        std::uint32_t chunkCount;
+        float chunkWidth;
+        std::uint32_t chunkTableOffset;
+        std::uint32_t reserved[3];
+    };
+
+    struct ChunkEntry
+    {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    struct ChunkRecord
+    {
+        std::uint32_t flags; // bit 0: changesFields
+        float electricX;
+        float electricY;
+        float magneticZ;
+        std::uint32_t laserCount;
+        std::uint32_t lasersOffset;
+        std::uint32_t scrollCount;
+        std::uint32_t scrollsOffset;
+        std::uint32_t gridColumns;
+        std::uint32_t gridRows;
+        std::uint32_t gridOffset;
+        std::uint32_t patternCount;
+        std::uint32_t patternsOffset;
+        std::uint32_t reserved;
+    };
+
+    static constexpr std::uint32_t FLAG_CHANGES_FIELDS = 1u;
+
+    MappedFile m_file;
+    const ChunkEntry *m_chunkTable = nullptr;
+    std::size_t m_chunkCount = 0;
+};
+
+#endif // LEVELFILE_H
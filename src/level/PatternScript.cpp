@@ -0,0 +1,689 @@
+// src/level/PatternScript.cpp
+#include "PatternScript.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    enum class TokenType
+    {
+        Number,
+        Name,
+        Symbol,
+        EndOfLine
+    };
+
+    struct Token
+    {
+        TokenType type;
+        std::string text;
+        float number = 0.f;
+    };
+
+    bool tokenize(const std::string &line, std::vector<Token> &tokens, std::string &error)
+    {
+        tokens.clear();
+        std::size_t i = 0;
+        while (i < line.size())
+        {
+            char c = line[i];
+            if (c == '#')
+            {
+                break;
+            }
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                ++i;
+                continue;
+            }
+            if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && i + 1 < line.size() && std::isdigit(static_cast<unsigned char>(line[i + 1]))))
+            {
+                const char *begin = line.c_str() + i;
+                char *end = nullptr;
+                float value = std::strtof(begin, &end);
+                std::size_t length = static_cast<std::size_t>(end - begin);
+                tokens.push_back({TokenType::Number, line.substr(i, length), value});
+                i += length;
+                continue;
+            }
+            if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+            {
+                std::size_t start = i;
+                while (i < line.size() && (std::isalnum(static_cast<unsigned char>(line[i])) || line[i] == '_'))
+                {
+                    ++i;
+                }
+                tokens.push_back({TokenType::Name, line.substr(start, i - start)});
+                continue;
+            }
+            // two-character operators first
+            if (i + 1 < line.size() && line[i + 1] == '=' && (c == '<' || c == '>' || c == '=' || c == '!'))
+            {
+                tokens.push_back({TokenType::Symbol, line.substr(i, 2)});
+                i += 2;
+                continue;
+            }
+            if (std::string("+-*/(),<>=").find(c) != std::string::npos)
+            {
+                tokens.push_back({TokenType::Symbol, std::string(1, c)});
+                ++i;
+                continue;
+            }
+            error = std::string("unexpected '") + c + "'";
+            return false;
+        }
+        tokens.push_back({TokenType::EndOfLine, ""});
+        return true;
+    }
+
+    struct Builtin
+    {
+        const char *name;
+        PatternBuiltin id;
+    };
+
+    const Builtin BUILTINS[] = {
+        {"i", PatternBuiltin::Index},
+        {"t", PatternBuiltin::Time},
+        {"ex", PatternBuiltin::ElectricX},
+        {"ey", PatternBuiltin::ElectricY},
+        {"b", PatternBuiltin::MagneticZ},
+        {"rand", PatternBuiltin::Random},
+    };
+
+    struct Function
+    {
+        const char *name;
+        PatternOp op;
+    };
+
+    const Function FUNCTIONS[] = {
+        {"sin", PatternOp::Sin},
+        {"cos", PatternOp::Cos},
+        {"abs", PatternOp::Abs},
+        {"floor", PatternOp::Floor},
+    };
+
+    const char *const KEYWORDS[] = {"pattern", "end", "let", "repeat", "if", "else", "wait", "fire", "shoot",
+                                    "top", "bottom", "left", "right"};
+
+    // one pass, line by line. blocks are patched when their end is reached
+    class Compiler
+    {
+    public:
+        bool compile(const std::string &source, PatternProgram &program, std::string &error)
+        {
+            std::istringstream lines(source);
+            std::string line;
+            while (std::getline(lines, line))
+            {
+                ++m_line;
+                if (!tokenize(line, m_tokens, m_error) || !statement())
+                {
+                    error = "line " + std::to_string(m_line) + ": " + m_error;
+                    return false;
+                }
+            }
+            if (m_inPattern)
+            {
+                error = "pattern '" + m_program.names.back() + "' is missing its end";
+                return false;
+            }
+            if (m_program.entries.empty())
+            {
+                error = "no patterns";
+                return false;
+            }
+            if (m_program.code.size() > 0xFFFF || m_program.constants.size() > 0xFFFF)
+            {
+                error = "too much code, split the file";
+                return false;
+            }
+            program = std::move(m_program);
+            return true;
+        }
+
+    private:
+        enum class BlockType
+        {
+            Repeat,
+            If,
+            Else
+        };
+
+        struct Block
+        {
+            BlockType type;
+            std::size_t patch; // operand to fill in with the address after the block
+            std::size_t body;  // Repeat: first instruction of the body
+        };
+
+        const Token &peek() const { return m_tokens[m_pos]; }
+        const Token &next() { return m_tokens[m_pos < m_tokens.size() - 1 ? m_pos++ : m_pos]; }
+        bool accept(const char *symbol)
+        {
+            if (peek().type == TokenType::Symbol && peek().text == symbol)
+            {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+        bool fail(const std::string &message)
+        {
+            m_error = message;
+            return false;
+        }
+
+        void emit(PatternOp op) { m_program.code.push_back(static_cast<std::uint8_t>(op)); }
+        void emit8(std::uint8_t value) { m_program.code.push_back(value); }
+        void emit16(std::size_t value)
+        {
+            m_program.code.push_back(static_cast<std::uint8_t>(value & 0xFF));
+            m_program.code.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFF));
+        }
+        std::size_t emitPlaceholder()
+        {
+            std::size_t at = m_program.code.size();
+            emit16(0);
+            return at;
+        }
+        void patch(std::size_t at)
+        {
+            std::size_t target = m_program.code.size();
+            m_program.code[at] = static_cast<std::uint8_t>(target & 0xFF);
+            m_program.code[at + 1] = static_cast<std::uint8_t>((target >> 8) & 0xFF);
+        }
+
+        bool push()
+        {
+            if (++m_depth > PatternScript::MAX_STACK)
+            {
+                return fail("expression is too deeply nested");
+            }
+            return true;
+        }
+
+        bool constant(float value)
+        {
+            std::size_t index = 0;
+            while (index < m_program.constants.size() && m_program.constants[index] != value)
+            {
+                ++index;
+            }
+            if (index == m_program.constants.size())
+            {
+                m_program.constants.push_back(value);
+            }
+            emit(PatternOp::PushConst);
+            emit16(index);
+            return push();
+        }
+
+        int findLocal(const std::string &name) const
+        {
+            for (std::size_t i = 0; i < m_locals.size(); ++i)
+            {
+                if (m_locals[i] == name)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        bool isReserved(const std::string &name) const
+        {
+            for (const Builtin &builtin : BUILTINS)
+            {
+                if (name == builtin.name)
+                    return true;
+            }
+            for (const Function &function : FUNCTIONS)
+            {
+                if (name == function.name)
+                    return true;
+            }
+            for (const char *keyword : KEYWORDS)
+            {
+                if (name == keyword)
+                    return true;
+            }
+            return false;
+        }
+
+        // expression := sum [compare sum]
+        bool expression()
+        {
+            if (!sum())
+            {
+                return false;
+            }
+            static const struct
+            {
+                const char *symbol;
+                PatternOp op;
+            } COMPARES[] = {{"<=", PatternOp::LessEqual}, {">=", PatternOp::GreaterEqual}, {"==", PatternOp::Equal},
+                            {"!=", PatternOp::NotEqual}, {"<", PatternOp::Less}, {">", PatternOp::Greater}};
+            for (const auto &compare : COMPARES)
+            {
+                if (accept(compare.symbol))
+                {
+                    if (!sum())
+                    {
+                        return false;
+                    }
+                    emit(compare.op);
+                    --m_depth;
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        bool sum()
+        {
+            if (!product())
+            {
+                return false;
+            }
+            while (true)
+            {
+                PatternOp op;
+                if (accept("+"))
+                    op = PatternOp::Add;
+                else if (accept("-"))
+                    op = PatternOp::Sub;
+                else
+                    return true;
+                if (!product())
+                {
+                    return false;
+                }
+                emit(op);
+                --m_depth;
+            }
+        }
+
+        bool product()
+        {
+            if (!unary())
+            {
+                return false;
+            }
+            while (true)
+            {
+                PatternOp op;
+                if (accept("*"))
+                    op = PatternOp::Mul;
+                else if (accept("/"))
+                    op = PatternOp::Div;
+                else
+                    return true;
+                if (!unary())
+                {
+                    return false;
+                }
+                emit(op);
+                --m_depth;
+            }
+        }
+
+        bool unary()
+        {
+            if (accept("-"))
+            {
+                if (!unary())
+                {
+                    return false;
+                }
+                emit(PatternOp::Neg);
+                return true;
+            }
+            return primary();
+        }
+
+        bool primary()
+        {
+            if (accept("("))
+            {
+                if (!expression())
+                {
+                    return false;
+                }
+                return accept(")") ? true : fail("expected ')'");
+            }
+            const Token &token = next();
+            if (token.type == TokenType::Number)
+            {
+                return constant(token.number);
+            }
+            if (token.type != TokenType::Name)
+            {
+                return fail(token.type == TokenType::EndOfLine ? "expected a value" : "unexpected '" + token.text + "'");
+            }
+            for (const Function &function : FUNCTIONS)
+            {
+                if (token.text == function.name)
+                {
+                    if (!accept("("))
+                    {
+                        return fail(token.text + " needs (...)");
+                    }
+                    if (!expression())
+                    {
+                        return false;
+                    }
+                    if (!accept(")"))
+                    {
+                        return fail("expected ')'");
+                    }
+                    emit(function.op);
+                    return true;
+                }
+            }
+            int local = findLocal(token.text);
+            if (local >= 0)
+            {
+                emit(PatternOp::LoadLocal);
+                emit8(static_cast<std::uint8_t>(local));
+                return push();
+            }
+            for (const Builtin &builtin : BUILTINS)
+            {
+                if (token.text == builtin.name)
+                {
+                    emit(PatternOp::LoadBuiltin);
+                    emit8(static_cast<std::uint8_t>(builtin.id));
+                    return push();
+                }
+            }
+            return fail("unknown name '" + token.text + "'");
+        }
+
+        // expressions separated by commas, each leaves one value on the stack
+        bool arguments(int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                if (i > 0 && !accept(","))
+                {
+                    return fail("expected " + std::to_string(count) + " values separated by commas");
+                }
+                if (!expression())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool statement()
+        {
+            m_pos = 0;
+            m_depth = 0;
+            const Token &first = next();
+            if (first.type == TokenType::EndOfLine)
+            {
+                return true;
+            }
+            if (first.type != TokenType::Name)
+            {
+                return fail("expected a statement");
+            }
+            const std::string &keyword = first.text;
+
+            if (keyword == "pattern")
+            {
+                const Token &name = next();
+                if (m_inPattern)
+                {
+                    return fail("pattern inside pattern '" + m_program.names.back() + "', missing end?");
+                }
+                if (name.type != TokenType::Name || isReserved(name.text))
+                {
+                    return fail("pattern needs a name");
+                }
+                if (m_program.find(name.text) >= 0)
+                {
+                    return fail("pattern '" + name.text + "' is defined twice");
+                }
+                m_program.names.push_back(name.text);
+                m_program.entries.push_back(static_cast<std::uint16_t>(m_program.code.size()));
+                m_locals.clear();
+                m_inPattern = true;
+                return endOfLine();
+            }
+            if (!m_inPattern)
+            {
+                return fail("'" + keyword + "' outside a pattern");
+            }
+
+            if (keyword == "end")
+            {
+                if (m_blocks.empty())
+                {
+                    emit(PatternOp::End);
+                    m_inPattern = false;
+                    return endOfLine();
+                }
+                Block block = m_blocks.back();
+                m_blocks.pop_back();
+                if (block.type == BlockType::Repeat)
+                {
+                    emit(PatternOp::LoopNext);
+                    emit16(block.body);
+                }
+                patch(block.patch);
+                return endOfLine();
+            }
+            if (keyword == "else")
+            {
+                if (m_blocks.empty() || m_blocks.back().type != BlockType::If)
+                {
+                    return fail("else without if");
+                }
+                emit(PatternOp::Jump);
+                std::size_t skip = emitPlaceholder();
+                patch(m_blocks.back().patch);
+                m_blocks.back() = {BlockType::Else, skip, 0};
+                return endOfLine();
+            }
+            if (keyword == "let")
+            {
+                const Token &name = next();
+                if (name.type != TokenType::Name || isReserved(name.text))
+                {
+                    return fail("let needs a name that isn't a built-in");
+                }
+                if (!accept("="))
+                {
+                    return fail("expected '='");
+                }
+                if (!expression())
+                {
+                    return false;
+                }
+                int local = findLocal(name.text);
+                if (local < 0)
+                {
+                    if (m_locals.size() >= PatternState::MAX_LOCALS)
+                    {
+                        return fail("more than " + std::to_string(PatternState::MAX_LOCALS) + " locals");
+                    }
+                    local = static_cast<int>(m_locals.size());
+                    m_locals.push_back(name.text);
+                }
+                emit(PatternOp::StoreLocal);
+                emit8(static_cast<std::uint8_t>(local));
+                return endOfLine();
+            }
+            if (keyword == "repeat")
+            {
+                std::size_t depth = 0;
+                for (const Block &block : m_blocks)
+                {
+                    depth += block.type == BlockType::Repeat ? 1 : 0;
+                }
+                if (depth >= PatternState::MAX_LOOP_DEPTH)
+                {
+                    return fail("repeat nested more than " + std::to_string(PatternState::MAX_LOOP_DEPTH) + " deep");
+                }
+                if (!expression())
+                {
+                    return false;
+                }
+                emit(PatternOp::LoopBegin);
+                std::size_t exit = emitPlaceholder();
+                m_blocks.push_back({BlockType::Repeat, exit, m_program.code.size()});
+                return endOfLine();
+            }
+            if (keyword == "if")
+            {
+                if (!expression())
+                {
+                    return false;
+                }
+                emit(PatternOp::JumpIfFalse);
+                m_blocks.push_back({BlockType::If, emitPlaceholder(), 0});
+                return endOfLine();
+            }
+            if (keyword == "wait")
+            {
+                if (!expression())
+                {
+                    return false;
+                }
+                emit(PatternOp::Wait);
+                return endOfLine();
+            }
+            if (keyword == "fire")
+            {
+                const Token &side = next();
+                static const char *const SIDES[] = {"top", "bottom", "left", "right"}; // LaserSide order
+                int sideIndex = -1;
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (side.text == SIDES[i])
+                    {
+                        sideIndex = i;
+                    }
+                }
+                if (sideIndex < 0)
+                {
+                    return fail("fire needs top, bottom, left or right");
+                }
+                if (!accept(","))
+                {
+                    return fail("fire needs side, along, speed");
+                }
+                if (!arguments(2))
+                {
+                    return false;
+                }
+                emit(PatternOp::Fire);
+                emit8(static_cast<std::uint8_t>(sideIndex));
+                return endOfLine();
+            }
+            if (keyword == "shoot")
+            {
+                if (!arguments(4))
+                {
+                    return false;
+                }
+                emit(PatternOp::Shoot);
+                return endOfLine();
+            }
+            return fail("unknown statement '" + keyword + "'");
+        }
+
+        bool endOfLine() { return peek().type == TokenType::EndOfLine ? true : fail("unexpected '" + peek().text + "'"); }
+
+        PatternProgram m_program;
+        std::vector<Token> m_tokens;
+        std::size_t m_pos = 0;
+        std::size_t m_depth = 0;
+        std::vector<Block> m_blocks;
+        std::vector<std::string> m_locals;
+        bool m_inPattern = false;
+        int m_line = 0;
+        std::string m_error;
+    };
+}
+
+int PatternProgram::find(const std::string &name) const
+{
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[i] == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool PatternScript::compile(const std::string &source, PatternProgram &out, std::string &error)
+{
+    Compiler compiler;
+    return compiler.compile(source, out, error);
+}
+
+void PatternScript::start(const PatternProgram &program, std::size_t pattern, std::uint32_t seed, PatternState &state)
+{
+    state = PatternState();
+    state.pc = program.entries[pattern % program.entries.size()];
+    state.rng = seed != 0 ? seed : 1; // xorshift never leaves 0
+}
+
+bool PatternLibrary::load(const std::string &filepath)
+{
+    m_path = filepath;
+    std::error_code ec;
+    m_modified = std::filesystem::last_write_time(m_path, ec);
+    return compileFile();
+}
+
+bool PatternLibrary::reloadIfChanged()
+{
+    if (m_path.empty())
+    {
+        return false;
+    }
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(m_path, ec);
+    if (ec || modified == m_modified)
+    {
+        return false;
+    }
+    m_modified = modified;
+    return compileFile();
+}
+
+bool PatternLibrary::compileFile()
+{
+    std::ifstream file(m_path);
+    if (!file)
+    {
+        std::cerr << "PatternLibrary: can't open " << m_path.string() << std::endl;
+        return false;
+    }
+    std::stringstream source;
+    source << file.rdbuf();
+
+    // a broken edit keeps the patterns that were already running
+    PatternProgram program;
+    std::string error;
+    if (!PatternScript::compile(source.str(), program, error))
+    {
+        std::cerr << "PatternLibrary: " << m_path.string() << ", " << error << std::endl;
+        return false;
+    }
+    m_program = std::move(program);
+    std::cout << "PatternLibrary: " << m_path.string() << " compiled, " << m_program.getPatternCount() << " patterns, "
+              << m_program.code.size() << " bytes" << std::endl;
+    return true;
+}
@@ -0,0 +1,345 @@
+// src/level/PatternScript.h
+#ifndef PATTERNSCRIPT_H
+#define PATTERNSCRIPT_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "LevelChunk.h"
+#include "../physics/PhysicsEngine.h"
+
+// laser wave patterns written by designers in a small text language, compiled once to bytecode
+//
+//   # comment
+//   pattern sweep               one block per pattern, referenced by name or by position in the file
+//       let x = rand            locals, up to MAX_LOCALS per pattern
+//       repeat 12               loop, i is the innermost loop's 0-based counter
+//           fire top, x, 260    from a screen edge (top/bottom/left/right), along 0..1, speed px/s
+//           shoot 0.5, 0, 90, 200   from screen point (0..1, 0..1), angle in degrees (0 = right, 90 = down), speed
+//           wait 0.1            seconds until the pattern continues
+//       end
+//       if b > 0 ... else ... end
+//   end
+//
+// expressions: numbers, locals, + - * / < <= > >= == != and parentheses
+// built-ins: i, t (seconds since the pattern started), ex, ey, b (current fields), rand (0..1)
+// functions: sin(deg), cos(deg), abs(x), floor(x)
+
+enum class PatternOp : std::uint8_t
+{
+    PushConst,   // u16 constant index
+    LoadLocal,   // u8 local
+    StoreLocal,  // u8 local, pops
+    LoadBuiltin, // u8 PatternBuiltin
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Neg,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    Sin,
+    Cos,
+    Abs,
+    Floor,
+    Jump,        // u16 address
+    JumpIfFalse, // u16 address, pops
+    LoopBegin,   // u16 address past the loop, pops the count
+    LoopNext,    // u16 address of the loop body
+    Wait,        // pops seconds, yields
+    Fire,        // u8 LaserSide, pops along and speed
+    Shoot,       // pops x, y, angle and speed
+    End
+};
+
+enum class PatternBuiltin : std::uint8_t
+{
+    Index,
+    Time,
+    ElectricX,
+    ElectricY,
+    MagneticZ,
+    Random
+};
+
+// everything compiled from one source, all patterns share the code and constants
+struct PatternProgram
+{
+    std::vector<std::uint8_t> code;
+    std::vector<float> constants;
+    std::vector<std::string> names;
+    std::vector<std::uint16_t> entries; // start address per pattern
+
+    std::size_t getPatternCount() const { return entries.size(); }
+    int find(const std::string &name) const;
+};
+
+// one running pattern. fixed size so instances live in a preallocated pool
+struct PatternState
+{
+    static constexpr std::size_t MAX_LOCALS = 8;
+    static constexpr std::size_t MAX_LOOP_DEPTH = 4;
+
+    struct Loop
+    {
+        std::uint16_t body;
+        std::int32_t index;
+        std::int32_t count;
+    };
+
+    std::uint16_t pc = 0;
+    std::uint8_t loopDepth = 0;
+    std::uint32_t rng = 1; // xorshift32, seeded per instance so a course replays the same
+    float locals[MAX_LOCALS] = {};
+    Loop loops[MAX_LOOP_DEPTH] = {};
+};
+
+// what the scene knows when a pattern resumes
+struct PatternEnv
+{
+    float time = 0.f; // seconds since the pattern started
+    FieldProperties fields;
+};
+
+// a laser the pattern wants spawned, in screen space
+struct PatternShot
+{
+    bool fromEdge = true;
+    LaserSide side = LaserSide::Top; // fromEdge: spawnLaser semantics
+    float along = 0.5f;
+    sf::Vector2f position;           // !fromEdge: 0..1 of the screen
+    float angle = 0.f;               // degrees
+    float speed = 200.f;
+};
+
+class PatternScript
+{
+public:
+    static constexpr std::size_t MAX_STACK = 16;
+    static constexpr int MAX_ITERATIONS = 4096; // loop iterations per resume, a huge repeat without a wait yields instead
+
+    // false with "line: message" in error if the source doesn't compile, out is left untouched
+    static bool compile(const std::string &source, PatternProgram &out, std::string &error);
+
+    static void start(const PatternProgram &program, std::size_t pattern, std::uint32_t seed, PatternState &state);
+
+    // runs until the pattern waits or ends, calling emit(const PatternShot &) for each laser
+    // returns the wait in seconds, or a negative number once the pattern has ended. never allocates
+    template <typename Emit>
+    static float run(const PatternProgram &program, PatternState &state, const PatternEnv &env, Emit &&emit);
+
+private:
+    static std::uint16_t operand16(const std::uint8_t *code, std::uint16_t at)
+    {
+        return static_cast<std::uint16_t>(code[at] | code[at + 1] << 8);
+    }
+};
+
+// a pattern source file that recompiles when it changes on disk
+class PatternLibrary
+{
+public:
+    bool load(const std::string &filepath);
+    // true if the file changed and compiled, running instances must be restarted against the new code
+    bool reloadIfChanged();
+
+    bool isLoaded() const { return !m_program.entries.empty(); }
+    const PatternProgram &getProgram() const { return m_program; }
+
+private:
+    bool compileFile();
+
+    std::filesystem::path m_path; // built once in load(), a std::string would be converted on every poll
+    std::filesystem::file_time_type m_modified{};
+    PatternProgram m_program;
+};
+
+template <typename Emit>
+float PatternScript::run(const PatternProgram &program, PatternState &state, const PatternEnv &env, Emit &&emit)
+{
+    const std::uint8_t *code = program.code.data();
+    float stack[MAX_STACK];
+    std::size_t sp = 0;
+    std::uint16_t pc = state.pc;
+    int iterations = 0;
+
+    // code is only ever produced by compile(), so operands and stack depth aren't checked here
+    while (true)
+    {
+        PatternOp op = static_cast<PatternOp>(code[pc++]);
+        switch (op)
+        {
+        case PatternOp::PushConst:
+            stack[sp++] = program.constants[operand16(code, pc)];
+            pc += 2;
+            break;
+        case PatternOp::LoadLocal:
+            stack[sp++] = state.locals[code[pc++]];
+            break;
+        case PatternOp::StoreLocal:
+            state.locals[code[pc++]] = stack[--sp];
+            break;
+        case PatternOp::LoadBuiltin:
+        {
+            float value = 0.f;
+            switch (static_cast<PatternBuiltin>(code[pc++]))
+            {
+            case PatternBuiltin::Index:
+                value = state.loopDepth > 0 ? static_cast<float>(state.loops[state.loopDepth - 1].index) : 0.f;
+                break;
+            case PatternBuiltin::Time:
+                value = env.time;
+                break;
+            case PatternBuiltin::ElectricX:
+                value = env.fields.electricField.x;
+                break;
+            case PatternBuiltin::ElectricY:
+                value = env.fields.electricField.y;
+                break;
+            case PatternBuiltin::MagneticZ:
+                value = env.fields.magneticField_Z;
+                break;
+            case PatternBuiltin::Random:
+                state.rng ^= state.rng << 13;
+                state.rng ^= state.rng >> 17;
+                state.rng ^= state.rng << 5;
+                value = static_cast<float>(state.rng >> 8) / 16777216.f;
+                break;
+            }
+            stack[sp++] = value;
+            break;
+        }
+        case PatternOp::Add:
+            --sp;
+            stack[sp - 1] += stack[sp];
+            break;
+        case PatternOp::Sub:
+            --sp;
+            stack[sp - 1] -= stack[sp];
+            break;
+        case PatternOp::Mul:
+            --sp;
+            stack[sp - 1] *= stack[sp];
+            break;
+        case PatternOp::Div:
+            --sp;
+            stack[sp - 1] = stack[sp] != 0.f ? stack[sp - 1] / stack[sp] : 0.f;
+            break;
+        case PatternOp::Neg:
+            stack[sp - 1] = -stack[sp - 1];
+            break;
+        case PatternOp::Less:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] < stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::LessEqual:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] <= stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::Greater:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] > stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::GreaterEqual:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] >= stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::Equal:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] == stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::NotEqual:
+            --sp;
+            stack[sp - 1] = stack[sp - 1] != stack[sp] ? 1.f : 0.f;
+            break;
+        case PatternOp::Sin:
+            stack[sp - 1] = std::sin(stack[sp - 1] * 0.017453293f);
+            break;
+        case PatternOp::Cos:
+            stack[sp - 1] = std::cos(stack[sp - 1] * 0.017453293f);
+            break;
+        case PatternOp::Abs:
+            stack[sp - 1] = std::fabs(stack[sp - 1]);
+            break;
+        case PatternOp::Floor:
+            stack[sp - 1] = std::floor(stack[sp - 1]);
+            break;
+        case PatternOp::Jump:
+            pc = operand16(code, pc);
+            break;
+        case PatternOp::JumpIfFalse:
+            pc = stack[--sp] != 0.f ? static_cast<std::uint16_t>(pc + 2) : operand16(code, pc);
+            break;
+        case PatternOp::LoopBegin:
+        {
+            // scripts are hot-reloaded designer input: NaN and anything out of int32 range must not reach the cast
+            constexpr float maxRepeat = 2147483520.f; // largest float below 2^31
+            float repeat = stack[--sp];
+            auto count = repeat >= 1.f ? static_cast<std::int32_t>(repeat < maxRepeat ? repeat : maxRepeat) : 0;
+            if (count <= 0)
+            {
+                pc = operand16(code, pc);
+                break;
+            }
+            pc += 2;
+            state.loops[state.loopDepth++] = {pc, 0, count};
+            break;
+        }
+        case PatternOp::LoopNext:
+        {
+            PatternState::Loop &loop = state.loops[state.loopDepth - 1];
+            if (++loop.index < loop.count)
+            {
+                pc = loop.body;
+                if (++iterations >= MAX_ITERATIONS)
+                {
+                    // between statements, so the stack is empty and nothing is lost
+                    state.pc = pc;
+                    return 0.f;
+                }
+            }
+            else
+            {
+                --state.loopDepth;
+                pc += 2;
+            }
+            break;
+        }
+        case PatternOp::Wait:
+            state.pc = pc;
+            return std::fmax(0.f, stack[--sp]);
+        case PatternOp::Fire:
+        {
+            PatternShot shot;
+            shot.side = static_cast<LaserSide>(code[pc++]);
+            shot.speed = stack[--sp];
+            shot.along = stack[--sp];
+            emit(shot);
+            break;
+        }
+        case PatternOp::Shoot:
+        {
+            PatternShot shot;
+            shot.fromEdge = false;
+            shot.speed = stack[--sp];
+            shot.angle = stack[--sp];
+            shot.position.y = stack[--sp];
+            shot.position.x = stack[--sp];
+            emit(shot);
+            break;
+        }
+        case PatternOp::End:
+            state.pc = static_cast<std::uint16_t>(pc - 1);
+            return -1.f;
+        }
+    }
+}
+
+#endif // PATTERNSCRIPT_H
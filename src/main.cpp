@@ -1,16 +1,152 @@
 #include "core/Game.h"
+#include "core/Benchmark.h"
+#include "core/AllocationTracker.h"
+#include "level/ChunkGenerator.h"
+#include "level/LevelFile.h"
 #include <iostream>
+#include <cstdlib>
+#include <algorithm>
 
 const unsigned int WINDOW_WIDTH = 1280;
 const unsigned int WINDOW_HEIGHT = 720;
 const std::string WINDOW_TITLE = "DenPaKid";
+const std::uint32_t EXPORTED_LEVEL_CHUNKS = 150; // 10 minutes at the default scroll speed, 4 s per chunk
 
-int main()
+int main(int argc, char *argv[])
 {
+    // --bench <steady|lasers|bfield|fields|switch|particles|all> [--bench-frames N] [--bench-out file.json] [--fail-on-alloc]
+    // --track-allocs: count allocations per frame and profiler scope (F3 overlay)
+    // --fps-cap N: pace frames to N fps, --no-vsync: turn vsync off (use with --fps-cap)
+    // --level file.dpkl: play an authored course, --export-level file.dpkl [--level-seed N]: write a generated one to start from
+    // --rewind-deaths: debug, freeze on death instead of ending the run (hold R to rewind)
+    // --run-ahead N: present the game N frames (0-3) ahead of the real state to cut input latency
+    // --hitch-ms X: frames over X ms write hitch_<frame>.txt (default twice the frame period, 0 = off)
+    // --render-scale X: draw the game world at X (0.5-1) of the window resolution and upscale it, the HUD stays native
+    // --quality N: pin the quality level (0 high .. 3 lowest) instead of adapting it to the frame time
+    bool benchMode = false;
+    BenchmarkOptions benchOptions;
+    unsigned int fpsCap = 0;
+    bool vsync = true;
+    std::string levelPath;
+    std::string exportLevelPath;
+    std::uint32_t levelSeed = 1;
+    bool rewindDeaths = false;
+    int runAheadFrames = 0;
+    double hitchBudgetMs = -1.0;
+    int qualityLevel = -1; // automatic
+    float renderScale = 1.f;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--bench" && i + 1 < argc)
+        {
+            benchMode = true;
+            benchOptions.scenario = argv[++i];
+        }
+        else if (arg == "--bench-frames" && i + 1 < argc)
+        {
+            benchOptions.frames = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--bench-out" && i + 1 < argc)
+        {
+            benchOptions.outputPath = argv[++i];
+        }
+        else if (arg == "--fail-on-alloc")
+        {
+            benchOptions.failOnAllocation = true;
+        }
+        else if (arg == "--track-allocs")
+        {
+            AllocationTracker::setEnabled(true);
+        }
+        else if (arg == "--fps-cap" && i + 1 < argc)
+        {
+            fpsCap = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        }
+        else if (arg == "--no-vsync")
+        {
+            vsync = false;
+        }
+        else if (arg == "--level" && i + 1 < argc)
+        {
+            levelPath = argv[++i];
+        }
+        else if (arg == "--export-level" && i + 1 < argc)
+        {
+            exportLevelPath = argv[++i];
+        }
+        else if (arg == "--level-seed" && i + 1 < argc)
+        {
+            levelSeed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--rewind-deaths")
+        {
+            rewindDeaths = true;
+        }
+        else if (arg == "--run-ahead" && i + 1 < argc)
+        {
+            runAheadFrames = std::atoi(argv[++i]);
+        }
+        else if (arg == "--hitch-ms" && i + 1 < argc)
+        {
+            hitchBudgetMs = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (arg == "--render-scale" && i + 1 < argc)
+        {
+            renderScale = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--quality" && i + 1 < argc)
+        {
+            qualityLevel = std::max(0, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "Ignoring unknown argument: " << arg << std::endl;
+        }
+    }
+
+    if (!exportLevelPath.empty())
+    {
+        std::vector<LevelChunkDesc> chunks;
+        for (std::uint32_t i = 0; i < EXPORTED_LEVEL_CHUNKS; ++i)
+        {
+            LevelChunk chunk = ChunkGenerator::generate(levelSeed, i);
+            chunks.push_back(LevelFile::describe(chunk.view()));
+        }
+        if (!LevelFile::write(exportLevelPath, chunks))
+        {
+            return EXIT_FAILURE;
+        }
+        std::cout << "Wrote " << chunks.size() << " chunks (seed " << levelSeed << ") to " << exportLevelPath << std::endl;
+        return EXIT_SUCCESS;
+    }
+
     try
     {
         Game game(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
         std::cout << "instancing game./ main.cpp" << std::endl;
+        game.setLevelPath(levelPath);
+        game.setRewindDeaths(rewindDeaths);
+        game.setRunAheadFrames(runAheadFrames);
+        game.setRenderScale(renderScale);
+        game.setVerticalSyncEnabled(vsync);
+        game.getFrameScheduler().setFpsCap(fpsCap);
+        if (hitchBudgetMs < 0.0)
+        {
+            // two frame periods: the cap, or a 60 Hz vsync
+            hitchBudgetMs = 2.0 * 1000.0 / (fpsCap > 0 ? fpsCap : 60);
+        }
+        game.setHitchBudgetMs(hitchBudgetMs);
+        game.getQualityGovernor().setBudgetMs(1000.0 / (fpsCap > 0 ? fpsCap : 60));
+        if (qualityLevel >= 0)
+        {
+            game.setQualityLevel(qualityLevel);
+        }
+        if (benchMode)
+        {
+            Benchmark benchmark(game, benchOptions);
+            return benchmark.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
         game.run();
     }
     catch (const std::exception &e)
@@ -24,4 +160,4 @@ int main()
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
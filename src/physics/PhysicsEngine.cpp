@@ -14,7 +14,7 @@ void PhysicsEngine::setPlayerMass(float mass)
     }
 }
 
-void PhysicsEngine::updatePlayer(Player &player, sf::Time dt, const FieldProperties &fields, const sf::Vector2u &windowSize)
+void PhysicsEngine::updatePlayer(Player &player, sf::Time dt, const FieldProperties &fields, const sf::FloatRect &bounds)
 {
     // std::cout << "update player./ PhysicsEngine.cpp" << std::endl;
     if (m_playerMass <= 0)
@@ -66,9 +66,9 @@ void PhysicsEngine::updatePlayer(Player &player, sf::Time dt, const FieldPropert
     sf::Vector2f currentPos = player.getPosition();
     sf::Vector2f currentVel = player.getVelocity();
 
-    if (currentPos.x - playerBounds.width / 2.f < 0)
+    if (currentPos.x - playerBounds.width / 2.f < bounds.left)
     {
-        player.setPosition(sf::Vector2f(playerBounds.width / 2.0f, currentPos.y));
+        player.setPosition(sf::Vector2f(bounds.left + playerBounds.width / 2.0f, currentPos.y));
         player.setVelocity(sf::Vector2f(-currentVel.x * restitution, currentVel.y));
     }
 
@@ -79,22 +79,22 @@ void PhysicsEngine::updatePlayer(Player &player, sf::Time dt, const FieldPropert
     //     player.setPosition(sf::Vector2f(windowSize.x - playerBounds.width / 2.f, player.getPosition().y)); // Use constructor
     //     player.setVelocity(sf::Vector2f(-newVelocity.x * restitution, newVelocity.y)); // Use constructor
     // }
-    else if (currentPos.x + playerBounds.width / 2.f > windowSize.x)
+    else if (currentPos.x + playerBounds.width / 2.f > bounds.left + bounds.width)
     {
-        player.setPosition(sf::Vector2f(windowSize.x - playerBounds.width / 2.f, currentPos.y));
+        player.setPosition(sf::Vector2f(bounds.left + bounds.width - playerBounds.width / 2.f, currentPos.y));
         player.setVelocity(sf::Vector2f(-currentVel.x * restitution, currentVel.y));
     }
 
     // top wall
-    if (currentPos.y - playerBounds.height / 2.f < 0)
+    if (currentPos.y - playerBounds.height / 2.f < bounds.top)
     {
-        player.setPosition(sf::Vector2f(currentPos.x, playerBounds.height / 2.f));
+        player.setPosition(sf::Vector2f(currentPos.x, bounds.top + playerBounds.height / 2.f));
         player.setVelocity(sf::Vector2f(currentVel.x, -currentVel.y * restitution));
     }
     // bottom wall
-    else if (currentPos.y + playerBounds.height / 2.f > windowSize.y)
+    else if (currentPos.y + playerBounds.height / 2.f > bounds.top + bounds.height)
     {
-        player.setPosition(sf::Vector2f(currentPos.x, windowSize.y - playerBounds.height / 2.f));
+        player.setPosition(sf::Vector2f(currentPos.x, bounds.top + bounds.height - playerBounds.height / 2.f));
         player.setVelocity(sf::Vector2f(currentVel.x, -currentVel.y * restitution));
     }
 
@@ -4,6 +4,7 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/Graphics/Rect.hpp>
 
 class Player;
 
@@ -21,8 +22,8 @@ public:
 
     void setPlayerMass(float mass);
 
-    // update velocity and position
-    void updatePlayer(Player &player, sf::Time deltaTime, const FieldProperties &fields, const sf::Vector2u &windowSize);
+    // update velocity and position, the player bounces off the edges of bounds (the camera rect in world space)
+    void updatePlayer(Player &player, sf::Time deltaTime, const FieldProperties &fields, const sf::FloatRect &bounds);
 
 private:
     float m_playerMass = 1.f;      // mass
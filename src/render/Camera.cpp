@@ -0,0 +1,33 @@
+// src/render/Camera.cpp
+#include "Camera.h"
+
+void Camera::reset(sf::Vector2f viewSize)
+{
+    m_view.setSize(viewSize);
+    m_view.setCenter(viewSize / 2.f);
+    m_rebasedDistance = 0.0;
+}
+
+void Camera::scroll(float dx)
+{
+    m_view.move(dx, 0.f);
+}
+
+sf::FloatRect Camera::getRect() const
+{
+    return sf::FloatRect(topLeft(), m_view.getSize());
+}
+
+void Camera::restore(float left, double rebasedDistance)
+{
+    m_view.setCenter(left + m_view.getSize().x / 2.f, m_view.getSize().y / 2.f);
+    m_rebasedDistance = rebasedDistance;
+}
+
+float Camera::rebase()
+{
+    float shift = -topLeft().x;
+    m_rebasedDistance -= shift;
+    m_view.move(shift, 0.f);
+    return shift;
+}
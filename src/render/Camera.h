@@ -0,0 +1,45 @@
+// src/render/Camera.h
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SFML/Graphics.hpp>
+
+// world-space view that scrolls along the course
+// float32 loses sub-pixel precision far from the origin, so once the camera is past
+// REBASE_THRESHOLD the owner shifts the whole world back by rebase() and keeps playing near 0
+class Camera
+{
+public:
+    // left edge at world x = 0
+    void reset(sf::Vector2f viewSize);
+    void scroll(float dx);
+
+    const sf::View &getView() const { return m_view; }
+    sf::FloatRect getRect() const;
+    bool isVisible(const sf::FloatRect &worldBounds) const { return getRect().intersects(worldBounds); }
+
+    // window pixel -> world, for things that spawn relative to the screen edges
+    sf::Vector2f screenToWorld(sf::Vector2f screen) const { return screen + topLeft(); }
+
+    bool needsRebase() const { return topLeft().x > REBASE_THRESHOLD; }
+    // moves the camera back to x = 0, every world position must be moved by the returned offset
+    float rebase();
+
+    // total scroll since reset, in double so it stays exact over hours
+    double getTravelled() const { return m_rebasedDistance + topLeft().x; }
+
+    // for snapshots: where the left edge is in the current world frame, and how far that frame was rebased
+    float getLeft() const { return topLeft().x; }
+    double getRebasedDistance() const { return m_rebasedDistance; }
+    void restore(float left, double rebasedDistance);
+
+    static constexpr float REBASE_THRESHOLD = 16384.f; // float ulp here is ~0.002 px
+
+private:
+    sf::Vector2f topLeft() const { return m_view.getCenter() - m_view.getSize() / 2.f; }
+
+    sf::View m_view;
+    double m_rebasedDistance = 0.0;
+};
+
+#endif // CAMERA_H
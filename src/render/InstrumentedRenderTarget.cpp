@@ -0,0 +1,166 @@
+// src/render/InstrumentedRenderTarget.cpp
+#include "InstrumentedRenderTarget.h"
+#include <iostream>
+
+void RenderStats::beginFrame()
+{
+    for (std::size_t i = 0; i < m_layerCount; ++i)
+    {
+        const char *name = m_current[i].name;
+        m_current[i] = RenderLayerStats();
+        m_current[i].name = name;
+    }
+    m_lastTexture = nullptr;
+    m_lastBlend = sf::BlendAlpha;
+    m_anyDraw = false;
+}
+
+void RenderStats::endFrame()
+{
+    m_lastFrame = m_current;
+    m_lastLayerCount = m_layerCount;
+}
+
+RenderLayerStats RenderStats::getTotal() const
+{
+    RenderLayerStats total;
+    total.name = "total";
+    for (std::size_t i = 0; i < m_lastLayerCount; ++i)
+    {
+        total.draws += m_lastFrame[i].draws;
+        total.vertices += m_lastFrame[i].vertices;
+        total.textureSwitches += m_lastFrame[i].textureSwitches;
+        total.blendChanges += m_lastFrame[i].blendChanges;
+    }
+    return total;
+}
+
+RenderLayerStats *RenderStats::findOrAddLayer(const char *name)
+{
+    for (std::size_t i = 0; i < m_layerCount; ++i)
+    {
+        if (m_current[i].name == name)
+        {
+            return &m_current[i];
+        }
+    }
+    if (m_layerCount < MAX_LAYERS - 1)
+    {
+        m_current[m_layerCount].name = name;
+        return &m_current[m_layerCount++];
+    }
+    // the last slot is "other", so an overflow shows up as such instead of inflating a real layer
+    if (m_layerCount == MAX_LAYERS - 1)
+    {
+        std::cerr << "RenderStats: more than " << MAX_LAYERS - 1 << " layers, \"" << name
+                  << "\" and any later ones are counted as \"other\"" << std::endl;
+        m_current[m_layerCount++].name = "other";
+    }
+    return &m_current[MAX_LAYERS - 1];
+}
+
+void RenderStats::count(RenderLayerStats *layer, std::size_t draws, std::size_t vertices, const sf::Texture *texture,
+                        const sf::BlendMode &blend)
+{
+    layer->draws += draws;
+    layer->vertices += vertices;
+    if (!m_anyDraw || texture != m_lastTexture)
+    {
+        ++layer->textureSwitches;
+        m_lastTexture = texture;
+    }
+    if (!m_anyDraw || blend != m_lastBlend)
+    {
+        ++layer->blendChanges;
+        m_lastBlend = blend;
+    }
+    m_anyDraw = true;
+}
+
+InstrumentedRenderTarget::InstrumentedRenderTarget(sf::RenderTarget &target, RenderStats &stats)
+    : m_target(target), m_stats(stats),
+      m_size(target.getSize()), m_defaultView(target.getDefaultView()), m_view(target.getView())
+{
+    setLayer("default");
+}
+
+InstrumentedRenderTarget::InstrumentedRenderTarget(sf::RenderTarget &target, RenderStats &stats, sf::Vector2u logicalSize,
+                                                   float viewportScale)
+    : m_target(target), m_stats(stats),
+      m_size(logicalSize), m_defaultView(sf::FloatRect(0.f, 0.f, static_cast<float>(logicalSize.x), static_cast<float>(logicalSize.y))),
+      m_viewportScale(viewportScale)
+{
+    setLayer("default");
+    setView(m_defaultView);
+}
+
+void InstrumentedRenderTarget::setView(const sf::View &view)
+{
+    m_view = view;
+    if (m_viewportScale == 1.f)
+    {
+        m_target.setView(view);
+        return;
+    }
+    sf::View scaled = view;
+    sf::FloatRect viewport = view.getViewport();
+    scaled.setViewport(sf::FloatRect(viewport.left * m_viewportScale, viewport.top * m_viewportScale,
+                                     viewport.width * m_viewportScale, viewport.height * m_viewportScale));
+    m_target.setView(scaled);
+}
+
+void InstrumentedRenderTarget::setLayer(const char *name)
+{
+    m_layer = m_stats.findOrAddLayer(name);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Sprite &sprite, const sf::RenderStates &states)
+{
+    m_stats.count(m_layer, 1, 4, sprite.getTexture(), states.blendMode);
+    m_target.draw(sprite, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Text &text, const sf::RenderStates &states)
+{
+    // 6 vertices per glyph, an upper bound since whitespace has none. the outline is a second pass
+    std::size_t glyphs = text.getString().getSize();
+    const sf::Texture *texture = text.getFont() ? &text.getFont()->getTexture(text.getCharacterSize()) : nullptr;
+    bool outlined = text.getOutlineThickness() != 0.f;
+    m_stats.count(m_layer, outlined ? 2 : 1, glyphs * 6 * (outlined ? 2 : 1), texture, states.blendMode);
+    m_target.draw(text, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Shape &shape, const sf::RenderStates &states)
+{
+    // fill is a triangle fan around the center, the outline a strip
+    std::size_t points = shape.getPointCount();
+    bool outlined = shape.getOutlineThickness() != 0.f;
+    m_stats.count(m_layer, outlined ? 2 : 1, points + 2 + (outlined ? (points + 1) * 2 : 0), shape.getTexture(), states.blendMode);
+    m_target.draw(shape, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::VertexArray &vertices, const sf::RenderStates &states)
+{
+    m_stats.count(m_layer, 1, vertices.getVertexCount(), states.texture, states.blendMode);
+    m_target.draw(vertices, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Vertex *vertices, std::size_t vertexCount, sf::PrimitiveType type,
+                                    const sf::RenderStates &states)
+{
+    m_stats.count(m_layer, 1, vertexCount, states.texture, states.blendMode);
+    m_target.draw(vertices, vertexCount, type, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Drawable &drawable, std::size_t vertexCount, const sf::Texture *texture,
+                                    const sf::RenderStates &states)
+{
+    m_stats.count(m_layer, 1, vertexCount, texture, states.blendMode);
+    m_target.draw(drawable, states);
+}
+
+void InstrumentedRenderTarget::draw(const sf::Drawable &drawable, const sf::RenderStates &states)
+{
+    m_stats.count(m_layer, 1, 0, states.texture, states.blendMode);
+    m_target.draw(drawable, states);
+}
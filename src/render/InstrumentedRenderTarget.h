@@ -0,0 +1,95 @@
+// src/render/InstrumentedRenderTarget.h
+#ifndef INSTRUMENTEDRENDERTARGET_H
+#define INSTRUMENTEDRENDERTARGET_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+struct RenderLayerStats
+{
+    const char *name = nullptr;
+    std::size_t draws = 0;           // draw calls SFML issues, a shape with an outline is two
+    std::size_t vertices = 0;
+    std::size_t textureSwitches = 0; // texture differs from the previous draw, in any layer
+    std::size_t blendChanges = 0;
+};
+
+// per-layer counts for one frame, shown by the F3 overlay and the benchmark report
+// layers are keyed by their name pointer and keep their slot between frames, so pass string literals
+// the game uses 10 names, the last slot collects anything past MAX_LAYERS - 1 as "other"
+class RenderStats
+{
+public:
+    static constexpr std::size_t MAX_LAYERS = 16;
+
+    void beginFrame();
+    void endFrame();
+
+    // last completed frame
+    std::size_t getLayerCount() const { return m_lastLayerCount; }
+    const RenderLayerStats &getLayer(std::size_t index) const { return m_lastFrame[index]; }
+    RenderLayerStats getTotal() const;
+
+private:
+    friend class InstrumentedRenderTarget;
+
+    RenderLayerStats *findOrAddLayer(const char *name);
+    void count(RenderLayerStats *layer, std::size_t draws, std::size_t vertices, const sf::Texture *texture, const sf::BlendMode &blend);
+
+    std::array<RenderLayerStats, MAX_LAYERS> m_current{};
+    std::array<RenderLayerStats, MAX_LAYERS> m_lastFrame{};
+    std::size_t m_layerCount = 0;
+    std::size_t m_lastLayerCount = 0;
+
+    // GPU state is global, switches are counted across layers
+    const sf::Texture *m_lastTexture = nullptr;
+    sf::BlendMode m_lastBlend = sf::BlendAlpha;
+    bool m_anyDraw = false;
+};
+
+// what scenes render through instead of sf::RenderWindow: forwards to the real target and counts what it submits
+// SFML doesn't expose what a Drawable sends to the target, so the common types get overloads that know
+// their geometry. anything else is counted as one draw with no vertices unless the caller says otherwise
+class InstrumentedRenderTarget
+{
+public:
+    InstrumentedRenderTarget(sf::RenderTarget &target, RenderStats &stats);
+    // reduced resolution: behaves like a logicalSize target but draws into the top-left viewportScale
+    // fraction of target, which the caller then upscales. views keep their logical meaning
+    InstrumentedRenderTarget(sf::RenderTarget &target, RenderStats &stats, sf::Vector2u logicalSize, float viewportScale);
+
+    // following draws count towards this layer
+    void setLayer(const char *name);
+
+    void clear(const sf::Color &color = sf::Color::Black) { m_target.clear(color); }
+    void setView(const sf::View &view);
+    const sf::View &getView() const { return m_view; }
+    const sf::View &getDefaultView() const { return m_defaultView; }
+    sf::Vector2u getSize() const { return m_size; }
+
+    void draw(const sf::Sprite &sprite, const sf::RenderStates &states = sf::RenderStates::Default);
+    void draw(const sf::Text &text, const sf::RenderStates &states = sf::RenderStates::Default);
+    void draw(const sf::Shape &shape, const sf::RenderStates &states = sf::RenderStates::Default);
+    void draw(const sf::VertexArray &vertices, const sf::RenderStates &states = sf::RenderStates::Default);
+    void draw(const sf::Vertex *vertices, std::size_t vertexCount, sf::PrimitiveType type,
+              const sf::RenderStates &states = sf::RenderStates::Default);
+    // a custom drawable that issues one draw call of vertexCount vertices with texture
+    void draw(const sf::Drawable &drawable, std::size_t vertexCount, const sf::Texture *texture,
+              const sf::RenderStates &states = sf::RenderStates::Default);
+    void draw(const sf::Drawable &drawable, const sf::RenderStates &states = sf::RenderStates::Default);
+
+    sf::RenderTarget &getTarget() { return m_target; }
+    RenderStats &getStats() { return m_stats; }
+
+private:
+    sf::RenderTarget &m_target;
+    RenderStats &m_stats;
+    RenderLayerStats *m_layer = nullptr;
+    sf::Vector2u m_size;
+    sf::View m_defaultView;
+    sf::View m_view;
+    float m_viewportScale = 1.f;
+};
+
+#endif // INSTRUMENTEDRENDERTARGET_H
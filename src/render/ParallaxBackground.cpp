@@ -0,0 +1,70 @@
+// src/render/ParallaxBackground.cpp
+#include "ParallaxBackground.h"
+#include <cmath>
+
+bool ParallaxBackground::addLayer(const sf::Texture &texture, float parallax, sf::Vector2f scale, sf::Color tint)
+{
+    if (m_layerCount == MAX_LAYERS)
+    {
+        return false;
+    }
+    Layer &layer = m_layers[m_layerCount++];
+    layer.texture = &texture;
+    layer.parallax = parallax;
+    layer.scale = scale;
+    for (sf::Vertex &vertex : layer.quad)
+    {
+        vertex.color = tint;
+    }
+    return true;
+}
+
+void ParallaxBackground::setLayerTexture(std::size_t index, const sf::Texture &texture, sf::Vector2f scale)
+{
+    if (index < m_layerCount)
+    {
+        m_layers[index].texture = &texture;
+        m_layers[index].scale = scale;
+    }
+}
+
+void ParallaxBackground::update(double travelled, sf::Vector2f screenSize)
+{
+    for (std::size_t i = 0; i < m_layerCount; ++i)
+    {
+        Layer &layer = m_layers[i];
+        if (!layer.texture || layer.texture->getSize().x == 0)
+        {
+            continue;
+        }
+        // wrapped in double before it becomes a float texture coordinate, the texture repeats anyway
+        double textureWidth = layer.texture->getSize().x;
+        auto offset = static_cast<float>(std::fmod(travelled * layer.parallax / layer.scale.x, textureWidth));
+        float width = screenSize.x / layer.scale.x;
+        float height = screenSize.y / layer.scale.y;
+
+        layer.quad[0].position = {0.f, 0.f};
+        layer.quad[1].position = {screenSize.x, 0.f};
+        layer.quad[2].position = {screenSize.x, screenSize.y};
+        layer.quad[3].position = {0.f, screenSize.y};
+        layer.quad[0].texCoords = {offset, 0.f};
+        layer.quad[1].texCoords = {offset + width, 0.f};
+        layer.quad[2].texCoords = {offset + width, height};
+        layer.quad[3].texCoords = {offset, height};
+    }
+}
+
+void ParallaxBackground::draw(InstrumentedRenderTarget &target) const
+{
+    for (std::size_t i = 0; i < m_layerCount; ++i)
+    {
+        const Layer &layer = m_layers[i];
+        if (!layer.texture)
+        {
+            continue;
+        }
+        sf::RenderStates states;
+        states.texture = layer.texture;
+        target.draw(layer.quad.data(), layer.quad.size(), sf::Quads, states);
+    }
+}
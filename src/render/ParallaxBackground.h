@@ -0,0 +1,44 @@
+// src/render/ParallaxBackground.h
+#ifndef PARALLAXBACKGROUND_H
+#define PARALLAXBACKGROUND_H
+
+#include "InstrumentedRenderTarget.h"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+// scrolling background drawn in screen space: every layer is one screen-sized quad of a repeated texture,
+// and scrolling only moves its texture rect. each pixel is filled once per layer, with no seam and
+// nothing to leapfrog. the offset comes from the camera's total travel, so snapshots and rebases need nothing
+class ParallaxBackground
+{
+public:
+    static constexpr std::size_t MAX_LAYERS = 4;
+
+    // farthest first. texture must be setRepeated(true) and outlive the layer.
+    // parallax 1 moves with the world, 0 stays put. scale is screen px per texture px
+    bool addLayer(const sf::Texture &texture, float parallax, sf::Vector2f scale, sf::Color tint = sf::Color::White);
+    // swap a layer's texture, e.g. a reduced-resolution copy, scale keeps its size on screen
+    void setLayerTexture(std::size_t index, const sf::Texture &texture, sf::Vector2f scale);
+    void clear() { m_layerCount = 0; }
+    std::size_t getLayerCount() const { return m_layerCount; }
+
+    // travelled: Camera::getTravelled(), double so the offset is still exact after hours
+    void update(double travelled, sf::Vector2f screenSize);
+    // one draw per layer, call with a screen-space view
+    void draw(InstrumentedRenderTarget &target) const;
+
+private:
+    struct Layer
+    {
+        const sf::Texture *texture = nullptr;
+        float parallax = 1.f;
+        sf::Vector2f scale{1.f, 1.f};
+        std::array<sf::Vertex, 4> quad;
+    };
+
+    std::array<Layer, MAX_LAYERS> m_layers{};
+    std::size_t m_layerCount = 0;
+};
+
+#endif // PARALLAXBACKGROUND_H
@@ -0,0 +1,234 @@
+// src/render/ParticleSystem.cpp
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_SSE2 1
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    float elapsedMs(Clock::time_point since)
+    {
+        return std::chrono::duration<float, std::milli>(Clock::now() - since).count();
+    }
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : m_capacity(capacity),
+      m_x(capacity), m_y(capacity),
+      m_vx(capacity), m_vy(capacity),
+      m_life(capacity), m_invSpan(capacity),
+      m_size(capacity), m_color(capacity),
+      m_vertices(sf::Quads, capacity * 4)
+{
+}
+
+sf::Image ParticleSystem::makeParticleImage(unsigned int size)
+{
+    sf::Image image;
+    image.create(size, size, sf::Color::Transparent);
+    float radius = size / 2.f;
+    for (unsigned int y = 0; y < size; ++y)
+    {
+        for (unsigned int x = 0; x < size; ++x)
+        {
+            float dx = (x + 0.5f - radius) / radius;
+            float dy = (y + 0.5f - radius) / radius;
+            float falloff = std::max(0.f, 1.f - std::sqrt(dx * dx + dy * dy));
+            image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(255.f * falloff * falloff)));
+        }
+    }
+    return image;
+}
+
+void ParticleSystem::setTextureRect(const sf::IntRect &region)
+{
+    float left = static_cast<float>(region.left);
+    float top = static_cast<float>(region.top);
+    float right = left + region.width;
+    float bottom = top + region.height;
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+        m_vertices[i * 4 + 0].texCoords = {left, top};
+        m_vertices[i * 4 + 1].texCoords = {right, top};
+        m_vertices[i * 4 + 2].texCoords = {right, bottom};
+        m_vertices[i * 4 + 3].texCoords = {left, bottom};
+    }
+}
+
+std::size_t ParticleSystem::emit(const ParticleEmitter &emitter, sf::Vector2f position, sf::Vector2f direction, float count)
+{
+    float scaled = count * m_emitScale * m_qualityScale;
+    auto wanted = static_cast<std::size_t>(scaled);
+    if (random01() < scaled - static_cast<float>(wanted))
+    {
+        ++wanted;
+    }
+    std::size_t room = m_capacity - m_count;
+    if (wanted > room)
+    {
+        m_dropped += wanted - room;
+        wanted = room;
+    }
+
+    float baseAngle = std::atan2(direction.y, direction.x);
+    for (std::size_t n = 0; n < wanted; ++n)
+    {
+        std::size_t i = m_count++;
+        float angle = baseAngle + (random01() * 2.f - 1.f) * emitter.spread;
+        float speed = emitter.speedMin + random01() * (emitter.speedMax - emitter.speedMin);
+        float life = emitter.lifeMin + random01() * (emitter.lifeMax - emitter.lifeMin);
+        m_x[i] = position.x;
+        m_y[i] = position.y;
+        m_vx[i] = std::cos(angle) * speed;
+        m_vy[i] = std::sin(angle) * speed;
+        m_life[i] = life;
+        m_invSpan[i] = 1.f / std::max(life, 0.001f);
+        m_size[i] = emitter.size;
+        m_color[i] = emitter.color;
+    }
+    return wanted;
+}
+
+void ParticleSystem::update(float dt)
+{
+    Clock::time_point start = Clock::now();
+    integrate(dt);
+    removeDead();
+    m_updateMs = elapsedMs(start);
+    adjustEmitScale();
+}
+
+void ParticleSystem::integrate(float dt)
+{
+    float drag = std::pow(DRAG_PER_SECOND, dt);
+    float fall = GRAVITY * dt;
+    std::size_t i = 0;
+#ifdef PARTICLES_SSE2
+    const __m128 vDt = _mm_set1_ps(dt);
+    const __m128 vDrag = _mm_set1_ps(drag);
+    const __m128 vFall = _mm_set1_ps(fall);
+    for (; i + 4 <= m_count; i += 4)
+    {
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(&m_vx[i]), vDrag);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_vy[i]), vDrag), vFall);
+        _mm_storeu_ps(&m_vx[i], vx);
+        _mm_storeu_ps(&m_vy[i], vy);
+        _mm_storeu_ps(&m_x[i], _mm_add_ps(_mm_loadu_ps(&m_x[i]), _mm_mul_ps(vx, vDt)));
+        _mm_storeu_ps(&m_y[i], _mm_add_ps(_mm_loadu_ps(&m_y[i]), _mm_mul_ps(vy, vDt)));
+        _mm_storeu_ps(&m_life[i], _mm_sub_ps(_mm_loadu_ps(&m_life[i]), vDt));
+    }
+#endif
+    // the tail, or everything without SSE2
+    for (; i < m_count; ++i)
+    {
+        m_vx[i] *= drag;
+        m_vy[i] = m_vy[i] * drag + fall;
+        m_x[i] += m_vx[i] * dt;
+        m_y[i] += m_vy[i] * dt;
+        m_life[i] -= dt;
+    }
+}
+
+void ParticleSystem::removeDead()
+{
+    // swap the last live particle into the hole, order doesn't matter with additive blending
+    for (std::size_t i = 0; i < m_count;)
+    {
+        if (m_life[i] > 0.f)
+        {
+            ++i;
+            continue;
+        }
+        std::size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_vx[i] = m_vx[last];
+        m_vy[i] = m_vy[last];
+        m_life[i] = m_life[last];
+        m_invSpan[i] = m_invSpan[last];
+        m_size[i] = m_size[last];
+        m_color[i] = m_color[last];
+    }
+}
+
+void ParticleSystem::adjustEmitScale()
+{
+    if (m_budgetMs <= 0.f)
+    {
+        m_emitScale = 1.f;
+        return;
+    }
+    // back off quickly, recover slowly so it doesn't oscillate around the budget
+    if (getLastCostMs() > m_budgetMs)
+    {
+        m_emitScale = std::max(MIN_EMIT_SCALE, m_emitScale * 0.8f);
+    }
+    else
+    {
+        m_emitScale = std::min(1.f, m_emitScale + 0.01f);
+    }
+}
+
+void ParticleSystem::translate(sf::Vector2f shift)
+{
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        m_x[i] += shift.x;
+        m_y[i] += shift.y;
+    }
+}
+
+void ParticleSystem::clear()
+{
+    m_count = 0;
+    m_dropped = 0;
+    m_emitScale = 1.f;
+}
+
+void ParticleSystem::draw(InstrumentedRenderTarget &target, const sf::Texture &texture)
+{
+    if (m_count == 0)
+    {
+        m_buildMs = 0.f;
+        return;
+    }
+    Clock::time_point start = Clock::now();
+    sf::Vertex *quad = &m_vertices[0];
+    for (std::size_t i = 0; i < m_count; ++i, quad += 4)
+    {
+        // fades out and shrinks to half size over its life
+        float t = std::max(0.f, m_life[i] * m_invSpan[i]);
+        float half = m_size[i] * (0.25f + 0.25f * t);
+        float x = m_x[i];
+        float y = m_y[i];
+        sf::Color color = m_color[i];
+        color.a = static_cast<sf::Uint8>(color.a * t);
+        quad[0].position = {x - half, y - half};
+        quad[1].position = {x + half, y - half};
+        quad[2].position = {x + half, y + half};
+        quad[3].position = {x - half, y + half};
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+    }
+    m_buildMs = elapsedMs(start);
+
+    sf::RenderStates states;
+    states.texture = &texture;
+    states.blendMode = sf::BlendAdd;
+    target.draw(&m_vertices[0], m_count * 4, sf::Quads, states);
+}
+
+float ParticleSystem::random01()
+{
+    // xorshift32, std::mt19937 is too heavy for thousands of calls per frame
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+    return (m_rngState >> 8) * (1.f / 16777216.f);
+}
@@ -0,0 +1,52 @@
+// src/render/SpriteBatch.h
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include "InstrumentedRenderTarget.h"
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+
+// collects sprites that share a texture (an atlas) into one vertex array, drawn with a single call.
+// the array is reused between frames, clear() keeps its capacity
+class SpriteBatch
+{
+public:
+    void clear() { m_vertices.clear(); }
+
+    // same geometry sf::Sprite would send: its texture rect transformed, tinted with its colour
+    void add(const sf::Sprite &sprite)
+    {
+        const sf::IntRect &rect = sprite.getTextureRect();
+        const sf::Transform &transform = sprite.getTransform();
+        sf::Color color = sprite.getColor();
+        float width = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+        float left = static_cast<float>(rect.left);
+        float top = static_cast<float>(rect.top);
+        float right = left + rect.width;
+        float bottom = top + rect.height;
+
+        m_vertices.append(sf::Vertex(transform.transformPoint(0.f, 0.f), color, {left, top}));
+        m_vertices.append(sf::Vertex(transform.transformPoint(width, 0.f), color, {right, top}));
+        m_vertices.append(sf::Vertex(transform.transformPoint(width, height), color, {right, bottom}));
+        m_vertices.append(sf::Vertex(transform.transformPoint(0.f, height), color, {left, bottom}));
+    }
+
+    std::size_t getSpriteCount() const { return m_vertices.getVertexCount() / 4; }
+
+    void draw(InstrumentedRenderTarget &target, const sf::Texture &texture) const
+    {
+        if (m_vertices.getVertexCount() == 0)
+        {
+            return;
+        }
+        sf::RenderStates states;
+        states.texture = &texture;
+        target.draw(m_vertices, states);
+    }
+
+private:
+    sf::VertexArray m_vertices{sf::Quads};
+};
+
+#endif // SPRITEBATCH_H
@@ -0,0 +1,252 @@
+// src/render/TextureAtlas.cpp
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+    unsigned int roundUp(unsigned int value, unsigned int align)
+    {
+        return (value + align - 1) / align * align;
+    }
+}
+
+void TextureAtlas::addFromFile(const std::string &name, const std::string &filepath, sf::Vector2u maxSize)
+{
+    sf::Image image;
+    if (!image.loadFromFile(filepath))
+    {
+        throw std::runtime_error("Failed to load texture: " + filepath);
+    }
+    add(name, image, maxSize);
+}
+
+void TextureAtlas::add(const std::string &name, const sf::Image &image, sf::Vector2u maxSize)
+{
+    Entry entry;
+    entry.name = name;
+    entry.image = downscale(image, maxSize);
+    m_entries.push_back(std::move(entry));
+    m_built = false;
+}
+
+bool TextureAtlas::build(const AtlasOptions &options)
+{
+    unsigned int padding = options.mipmaps ? std::max(options.padding, 4u) : options.padding;
+    unsigned int align = options.mipmaps ? 4 : 1;
+    unsigned int maxSize = options.maxSize > 0 ? options.maxSize : sf::Texture::getMaximumSize();
+
+    // smallest power of two square-ish sheet that holds everything
+    unsigned int width = 64;
+    unsigned int height = 64;
+    while (!pack(width, height, padding, align))
+    {
+        if (width >= maxSize && height >= maxSize)
+        {
+            std::cerr << "TextureAtlas: " << m_entries.size() << " images don't fit " << maxSize << "x" << maxSize << std::endl;
+            return false;
+        }
+        if (width <= height && width < maxSize)
+            width *= 2;
+        else
+            height *= 2;
+    }
+
+    sf::Image sheet;
+    sheet.create(width, height, sf::Color::Transparent);
+    for (const Entry &entry : m_entries)
+    {
+        blit(sheet, entry.image, {static_cast<unsigned int>(entry.region.left), static_cast<unsigned int>(entry.region.top)}, padding);
+    }
+    if (!m_texture.loadFromImage(sheet))
+    {
+        return false;
+    }
+    m_texture.setSmooth(options.smooth);
+    if (options.mipmaps && !m_texture.generateMipmap())
+    {
+        std::cerr << "TextureAtlas: mipmaps not supported, using the base level only" << std::endl;
+    }
+
+    // the pixels live on the GPU now
+    for (Entry &entry : m_entries)
+    {
+        entry.image = sf::Image();
+    }
+    m_built = true;
+    std::cout << "TextureAtlas: " << m_entries.size() << " regions in " << width << "x" << height << std::endl;
+    return true;
+}
+
+sf::IntRect TextureAtlas::getRegion(const std::string &name) const
+{
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.name == name)
+        {
+            return entry.region;
+        }
+    }
+    return {};
+}
+
+sf::Image TextureAtlas::downscale(const sf::Image &image, sf::Vector2u maxSize)
+{
+    sf::Vector2u size = image.getSize();
+    if ((maxSize.x == 0 && maxSize.y == 0) || size.x == 0 || size.y == 0 ||
+        ((maxSize.x == 0 || size.x <= maxSize.x) && (maxSize.y == 0 || size.y <= maxSize.y)))
+    {
+        return image;
+    }
+    float scale = 1.f;
+    if (maxSize.x > 0)
+        scale = std::min(scale, static_cast<float>(maxSize.x) / size.x);
+    if (maxSize.y > 0)
+        scale = std::min(scale, static_cast<float>(maxSize.y) / size.y);
+    unsigned int width = std::max(1u, static_cast<unsigned int>(size.x * scale + 0.5f));
+    unsigned int height = std::max(1u, static_cast<unsigned int>(size.y * scale + 0.5f));
+
+    // every output pixel averages the source block it covers, colour weighted by alpha so transparent
+    // pixels don't darken the edges
+    const sf::Uint8 *src = image.getPixelsPtr();
+    std::vector<sf::Uint8> pixels(static_cast<std::size_t>(width) * height * 4);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        unsigned int y0 = y * size.y / height;
+        unsigned int y1 = std::max(y0 + 1, (y + 1) * size.y / height);
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            unsigned int x0 = x * size.x / width;
+            unsigned int x1 = std::max(x0 + 1, (x + 1) * size.x / width);
+            double r = 0.0, g = 0.0, b = 0.0, a = 0.0;
+            for (unsigned int sy = y0; sy < y1; ++sy)
+            {
+                const sf::Uint8 *row = src + (static_cast<std::size_t>(sy) * size.x + x0) * 4;
+                for (unsigned int sx = x0; sx < x1; ++sx, row += 4)
+                {
+                    double alpha = row[3];
+                    r += row[0] * alpha;
+                    g += row[1] * alpha;
+                    b += row[2] * alpha;
+                    a += alpha;
+                }
+            }
+            double count = static_cast<double>(x1 - x0) * (y1 - y0);
+            sf::Uint8 *out = &pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+            out[0] = a > 0.0 ? static_cast<sf::Uint8>(r / a + 0.5) : 0;
+            out[1] = a > 0.0 ? static_cast<sf::Uint8>(g / a + 0.5) : 0;
+            out[2] = a > 0.0 ? static_cast<sf::Uint8>(b / a + 0.5) : 0;
+            out[3] = static_cast<sf::Uint8>(a / count + 0.5);
+        }
+    }
+    sf::Image result;
+    result.create(width, height, pixels.data());
+    return result;
+}
+
+bool TextureAtlas::pack(unsigned int width, unsigned int height, unsigned int padding, unsigned int align)
+{
+    // skyline: the top edge of what has been placed, as (x, y, width) segments left to right
+    struct Segment
+    {
+        unsigned int x, y, width;
+    };
+    std::vector<Segment> skyline{{0, 0, width}};
+
+    std::vector<std::size_t> order(m_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](std::size_t l, std::size_t r)
+              { return m_entries[l].image.getSize().y > m_entries[r].image.getSize().y; });
+
+    for (std::size_t index : order)
+    {
+        Entry &entry = m_entries[index];
+        unsigned int w = roundUp(entry.image.getSize().x + padding * 2, align);
+        unsigned int h = roundUp(entry.image.getSize().y + padding * 2, align);
+
+        // lowest spot, then leftmost: the rect rests on the highest segment it spans
+        std::size_t best = skyline.size();
+        unsigned int bestY = 0;
+        for (std::size_t i = 0; i < skyline.size(); ++i)
+        {
+            unsigned int x = skyline[i].x;
+            if (x + w > width)
+            {
+                break;
+            }
+            unsigned int y = 0;
+            unsigned int covered = 0;
+            for (std::size_t j = i; covered < w; ++j)
+            {
+                y = std::max(y, skyline[j].y);
+                covered += skyline[j].width;
+            }
+            if (y + h <= height && (best == skyline.size() || y < bestY))
+            {
+                best = i;
+                bestY = y;
+            }
+        }
+        if (best == skyline.size())
+        {
+            return false;
+        }
+
+        unsigned int x = skyline[best].x;
+        entry.region = sf::IntRect(static_cast<int>(x + padding), static_cast<int>(bestY + padding),
+                                   static_cast<int>(entry.image.getSize().x), static_cast<int>(entry.image.getSize().y));
+
+        // raise the covered segments to the rect's top, trimming the one it partly covers
+        Segment raised{x, bestY + h, w};
+        std::size_t end = best;
+        while (end < skyline.size() && skyline[end].x + skyline[end].width <= x + w)
+        {
+            ++end;
+        }
+        if (end < skyline.size() && skyline[end].x < x + w)
+        {
+            unsigned int cut = x + w - skyline[end].x;
+            skyline[end].x += cut;
+            skyline[end].width -= cut;
+        }
+        skyline.erase(skyline.begin() + best, skyline.begin() + end);
+        skyline.insert(skyline.begin() + best, raised);
+
+        // neighbours at the same height become one segment
+        for (std::size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].y == skyline[i + 1].y)
+            {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+    return true;
+}
+
+void TextureAtlas::blit(sf::Image &atlas, const sf::Image &image, sf::Vector2u at, unsigned int padding)
+{
+    sf::Vector2u size = image.getSize();
+    atlas.copy(image, at.x, at.y);
+    // extrude the border into the padding, clamped to the source like a clamped sampler would
+    for (int y = -static_cast<int>(padding); y < static_cast<int>(size.y + padding); ++y)
+    {
+        for (int x = -static_cast<int>(padding); x < static_cast<int>(size.x + padding); ++x)
+        {
+            if (x >= 0 && y >= 0 && x < static_cast<int>(size.x) && y < static_cast<int>(size.y))
+            {
+                continue;
+            }
+            unsigned int sx = static_cast<unsigned int>(std::max(0, std::min(x, static_cast<int>(size.x) - 1)));
+            unsigned int sy = static_cast<unsigned int>(std::max(0, std::min(y, static_cast<int>(size.y) - 1)));
+            atlas.setPixel(at.x + x, at.y + y, image.getPixel(sx, sy));
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// src/render/TextureAtlas.h
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+struct AtlasOptions
+{
+    unsigned int padding = 2;  // px around every region, filled by extruding its edge so filtering doesn't bleed
+    bool mipmaps = false;      // regions are then aligned to 4 px and padded at least 4 so the first levels stay clean
+    bool smooth = true;
+    unsigned int maxSize = 0;  // 0 = sf::Texture::getMaximumSize()
+};
+
+// packs images into one texture at load time (skyline bottom-left, tallest first) so sprites of
+// different kinds can share a draw call. sprites use it with setTexture(atlas) + setTextureRect(region)
+class TextureAtlas
+{
+public:
+    // maxSize scales the image down (box filter, aspect kept) to fit, {0, 0} keeps it as is.
+    // throws std::runtime_error if the file doesn't load, like ResourceManager
+    void addFromFile(const std::string &name, const std::string &filepath, sf::Vector2u maxSize = {0, 0});
+    void add(const std::string &name, const sf::Image &image, sf::Vector2u maxSize = {0, 0});
+
+    // packs and uploads everything added so far, false if it doesn't fit maxSize
+    bool build(const AtlasOptions &options = AtlasOptions());
+
+    bool isBuilt() const { return m_built; }
+    const sf::Texture &getTexture() const { return m_texture; }
+    // empty rect if there is no such region
+    sf::IntRect getRegion(const std::string &name) const;
+
+    // what add() uses, also for reduced-resolution copies of textures that aren't in an atlas
+    static sf::Image downscale(const sf::Image &image, sf::Vector2u maxSize);
+
+private:
+    struct Entry
+    {
+        std::string name;
+        sf::Image image;
+        sf::IntRect region;
+    };
+
+    // positions every entry inside width x height, false if they don't fit
+    bool pack(unsigned int width, unsigned int height, unsigned int padding, unsigned int align);
+    static void blit(sf::Image &atlas, const sf::Image &image, sf::Vector2u at, unsigned int padding);
+
+    std::vector<Entry> m_entries;
+    sf::Texture m_texture;
+    bool m_built = false;
+};
+
+#endif // TEXTUREATLAS_H
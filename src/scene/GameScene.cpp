@@ -1,16 +1,72 @@
 #include "GameScene.h"
 #include "../render/ResourceManager.h"
+#include "../core/Profiler.h"
+#include "../core/FlightRecorder.h"
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
 
 const float PADDING = 10.f;
 const float PLAYER_START_Y_OFFSET = -100.f;
 const float BOTTOM_LASER_HEIGHT = 10.f;
 
+namespace
+{
+    // particle effects, see ParticleSystem
+    const float LASER_TRAIL_RATE = 40.f; // per laser per second, only lasers on screen emit
+    ParticleEmitter laserTrail()
+    {
+        ParticleEmitter emitter;
+        emitter.speedMin = 10.f;
+        emitter.speedMax = 60.f;
+        emitter.spread = 0.35f;
+        emitter.lifeMin = 0.2f;
+        emitter.lifeMax = 0.45f;
+        emitter.size = 7.f;
+        emitter.color = sf::Color(255, 90, 60, 200);
+        return emitter;
+    }
+    const ParticleEmitter LASER_TRAIL = laserTrail();
+
+    const float DASH_BURST_COUNT = 150.f;
+    ParticleEmitter dashBurst()
+    {
+        ParticleEmitter emitter;
+        emitter.speedMin = 80.f;
+        emitter.speedMax = 320.f;
+        emitter.spread = 0.9f;
+        emitter.lifeMin = 0.25f;
+        emitter.lifeMax = 0.55f;
+        emitter.size = 9.f;
+        emitter.color = sf::Color(90, 230, 255, 220);
+        return emitter;
+    }
+    const ParticleEmitter DASH_BURST = dashBurst();
+
+    const float CHARGE_SPARK_COUNT = 50.f;
+    ParticleEmitter chargeSpark(sf::Color color)
+    {
+        ParticleEmitter emitter;
+        emitter.speedMin = 40.f;
+        emitter.speedMax = 160.f;
+        emitter.spread = 3.14159265f;
+        emitter.lifeMin = 0.15f;
+        emitter.lifeMax = 0.35f;
+        emitter.size = 5.f;
+        emitter.color = color;
+        return emitter;
+    }
+    const ParticleEmitter POSITIVE_SPARK = chargeSpark(sf::Color(255, 120, 90, 230));
+    const ParticleEmitter NEGATIVE_SPARK = chargeSpark(sf::Color(110, 150, 255, 230));
+}
+
 GameScene::GameScene(Game &game)
     : Scene(game),
-      m_playerTexture(),
+      m_rewind(REWIND_BUDGET_BYTES, REWIND_MAX_RECORDS, REWIND_KEYFRAME_INTERVAL),
       m_rng(std::random_device{}())
 {
     // std::cout << "GameScene created. /GameScene.cpp" << std::endl;
@@ -18,10 +74,6 @@ GameScene::GameScene(Game &game)
 
 GameScene::~GameScene()
 {
-    if (m_gameMusic.getStatus() == sf::Music::Playing)
-    {
-        m_gameMusic.stop();
-    }
     // std::cout << "GameScene destroyed." << std::endl;
 }
 
@@ -31,13 +83,26 @@ void GameScene::loadAssets()
     try
     {
         m_hudFont = ResourceManager::getInstance().getDefaultFont();
-        m_playerTexture = ResourceManager::getInstance().loadTexture("player", "../../assets/images/player_sprite.png");
+        // gameplay sprites, packed at about twice the size they're drawn at so they stay sharp when scaled
+        m_atlas.addFromFile("player", "../../assets/images/player_sprite.png", {128, 256});
+        m_atlas.addFromFile("scroll", "../../assets/images/scroll_item.png", {96, 96});
+        m_atlas.addFromFile("laser", "../../assets/images/laser.png", {256, 32});
+        m_atlas.add("particle", ParticleSystem::makeParticleImage());
+        AtlasOptions atlasOptions;
+        atlasOptions.mipmaps = true; // lasers and scrolls are minified a lot
+        if (m_atlas.build(atlasOptions))
+        {
+            m_playerRegion = m_atlas.getRegion("player");
+            m_scrollRegion = m_atlas.getRegion("scroll");
+            m_laserRegion = m_atlas.getRegion("laser");
+            m_particles.setTextureRect(m_atlas.getRegion("particle"));
+        }
 
         sf::Vector2f playerStartPos = {
             static_cast<float>(m_game.getWindow().getSize().x) / 5.f,
             static_cast<float>(m_game.getWindow().getSize().y) / 2.f};
         // create the player object
-        m_player = std::make_unique<Player>(playerStartPos, m_playerTexture);
+        m_player = std::make_unique<Player>(playerStartPos, m_atlas.getTexture(), m_playerRegion);
         m_player->setCharge(1.0f);
         m_player->setVelocity({100.f, 0.f});
 
@@ -48,65 +113,112 @@ void GameScene::loadAssets()
         float bgScaleX = static_cast<float>(m_game.getWindow().getSize().x) / m_gameBgTexture.getSize().x;
         float bgScaleY = static_cast<float>(m_game.getWindow().getSize().y) / m_gameBgTexture.getSize().y;
         float uniformScale = std::max(bgScaleX, bgScaleY);
+        m_bgScale = uniformScale;
 
-        m_backgroundSprite1.setTexture(m_gameBgTexture);
-        m_backgroundSprite2.setTexture(m_gameBgTexture);
-
-        m_backgroundSprite1.setScale(uniformScale, uniformScale);
-        m_backgroundSprite2.setScale(uniformScale, uniformScale);
-
-        float scaledBgWidth = m_gameBgTexture.getSize().x * uniformScale;
+        // reduced copies for the quality governor, made once here rather than on a slow frame
+        sf::Image bgImage = m_gameBgTexture.copyToImage();
+        for (std::size_t i = 0; i < m_reducedBgTextures.size(); ++i)
+        {
+            unsigned int divisor = 2u << i;
+            m_reducedBgTextures[i].loadFromImage(TextureAtlas::downscale(bgImage, {bgImage.getSize().x / divisor, bgImage.getSize().y / divisor}));
+            m_reducedBgTextures[i].setRepeated(true);
+            m_reducedBgTextures[i].setSmooth(true);
+        }
 
-        m_backgroundSprite1.setPosition(0, 0);
-        m_backgroundSprite2.setPosition(scaledBgWidth - 1, 0);
+        // one layer for now, the texture rect scrolls with the camera
+        m_background.clear();
+        m_background.addLayer(m_gameBgTexture, 1.f, {uniformScale, uniformScale});
 
         m_bgScrollSpeed = 150.f;
-        // m_backgroundSprite1.setTexture(m_gameBgTexture);
-        // m_backgroundSprite2.setTexture(m_gameBgTexture);
-
-        // // Ensure texture repeats or is wide enough. For scrolling, two sprites are common.
-        // m_backgroundSprite1.setPosition(0, 0);
-        // m_backgroundSprite2.setPosition(m_gameBgTexture.getSize().x, 0); // Position second sprite after the first
-        //                                                                  // Scale to fit height, width will scroll
-        // float bgScaleY = static_cast<float>(m_game.getWindow().getSize().y) / m_gameBgTexture.getSize().y;
-        // m_backgroundSprite1.setScale(bgScaleY, bgScaleY); // Assuming square pixels in texture, scale uniformly based on height
-        // m_backgroundSprite2.setScale(bgScaleY, bgScaleY);
-        // // Adjust scroll speed based on scaled width
-        // float scaledBgWidth = m_gameBgTexture.getSize().x * m_backgroundSprite1.getScale().x;
-        // m_backgroundSprite1.setPosition(0, 0);
-        // m_backgroundSprite2.setPosition(scaledBgWidth, 0);
-
-        // music
-        if (!m_gameMusic.openFromFile("../../assets/audio/game_theme.ogg"))
-        {
-            throw std::runtime_error("Failed to load game_theme.ogg");
-        }
-        m_gameMusic.setLoop(true);
-        m_gameMusic.setVolume(m_game.getMasterVolume() * 0.7f);
-        m_gameMusic.play();
 
         // laser sound
-        m_laserSound.setBuffer(ResourceManager::getInstance().loadSoundBuffer("laser_fire", "../../assets/audio/laser_sound.ogg"));
-        m_laserSound.setVolume(m_game.getMasterVolume() * 0.5f);
-
-        // scroll
-        m_scrollItemTexture = ResourceManager::getInstance().loadTexture("scroll_item", "../../assets/images/scroll_item.png");
-
-        m_laserTexture = ResourceManager::getInstance().loadTexture("laser_beam", "../../assets/images/laser.png");
+        m_laserSoundBuffer = &ResourceManager::getInstance().loadSoundBuffer("laser_fire", "../../assets/audio/laser_sound.ogg");
     }
     catch (const std::runtime_error &e)
     {
         std::cerr << "Error loading assets in GameScene: " << e.what() << std::endl;
     }
-    setupInitialState();
+
+    // authored course, falls back to generating one if the file is missing or invalid
+    if (!m_game.getLevelPath().empty() && m_levelFile.open(m_game.getLevelPath()))
+    {
+        std::cout << "GameScene: playing " << m_game.getLevelPath() << " (" << m_levelFile.getChunkCount() << " chunks)" << std::endl;
+    }
+
+    // scripted waves, chunks that trigger one stay quiet if the file doesn't compile
+    m_patterns.load("../../assets/patterns/waves.pat");
+    m_patternInstances.resize(MAX_PATTERN_INSTANCES);
+    stopPatterns();
+
+    // HUD
+    float hudX = m_game.getWindow().getSize().x - 250.f;
+    m_hud.setFont(m_hudFont, 24);
+    m_distanceField = m_hud.addField("Distance: ", {hudX, 20.f}, sf::Color::White);
+    m_chargeField = m_hud.addField("Charge: ", {hudX, 50.f}, sf::Color::White, 1);
+    m_dashChargesField = m_hud.addField("Dash: ", {hudX, 80.f}, sf::Color::Cyan);
+
+    // field glyphs are baked once here, a rebuild only copies their rects
+    m_bOutGlyph = m_hudFont.getGlyph('.', FIELD_GLYPH_SIZE, false);
+    m_bInGlyph = m_hudFont.getGlyph('X', FIELD_GLYPH_SIZE, false);
+    m_fieldVertices.reserve((MAX_B_FIELD_SYMBOLS_PER_ROW_COL * MAX_B_FIELD_SYMBOLS_PER_ROW_COL + E_FIELD_LINES * 2) * 4);
     // std::cout << "GameScene assets loaded." << std::endl;
 }
 
+void GameScene::onEnter()
+{
+    // a restart only resets gameplay, assets and player stay loaded
+    setupInitialState();
+    m_game.getMusicService().crossfadeTo(MusicTrack::Game, sf::seconds(1.f), true);
+}
+
+void GameScene::onExit()
+{
+    m_chunkGenerator.stop();
+    m_game.getAudioMixer().stopAllSounds();
+}
+
+void GameScene::onQualityChanged()
+{
+    const QualitySettings &settings = m_game.getQualityGovernor().getSettings();
+    if (settings.bFieldDensity != m_bFieldDensityScale)
+    {
+        m_bFieldDensityScale = settings.bFieldDensity;
+        m_fieldVisualsValid = false; // rebuilt on the next update
+    }
+    m_particles.setQualityScale(settings.particles);
+    setBackgroundResolution(settings.backgroundDivisor);
+}
+
+void GameScene::setBackgroundResolution(unsigned int divisor)
+{
+    if (divisor == m_bgDivisor || m_gameBgTexture.getSize().x == 0)
+    {
+        return;
+    }
+    const sf::Texture *texture = &m_gameBgTexture;
+    for (std::size_t i = 0; i < m_reducedBgTextures.size(); ++i)
+    {
+        if (divisor >= (2u << i) && m_reducedBgTextures[i].getSize().x > 0)
+        {
+            texture = &m_reducedBgTextures[i];
+        }
+    }
+    m_bgDivisor = divisor;
+    // same size on screen, the reduced texture is just stretched further
+    sf::Vector2f scale(m_gameBgTexture.getSize().x * m_bgScale / texture->getSize().x,
+                       m_gameBgTexture.getSize().y * m_bgScale / texture->getSize().y);
+    m_background.setLayerTexture(0, *texture, scale);
+}
+
 void GameScene::setupInitialState()
 {
     // std::cout << "set up initial state. /GameScene.cpp" << std::endl;
     m_isGameOver = false;
+    m_rewinding = false;
+    m_frozenAtDeath = false;
+    m_speculative = false;
     m_distanceTraveled = 0.f;
+    m_camera.reset(sf::Vector2f(m_game.getWindow().getSize()));
     if (m_player)
     {
         m_player->setPosition({static_cast<float>(m_game.getWindow().getSize().x) / 5.f,
@@ -116,22 +228,6 @@ void GameScene::setupInitialState()
         m_player->resetDashCharges();
     }
 
-    // HUD
-    m_distanceText.setFont(m_hudFont);
-    m_distanceText.setCharacterSize(24);
-    m_distanceText.setFillColor(sf::Color::White);
-    m_distanceText.setPosition(m_game.getWindow().getSize().x - 250.f, 20.f);
-
-    m_chargeText.setFont(m_hudFont);
-    m_chargeText.setCharacterSize(24);
-    m_chargeText.setFillColor(sf::Color::White);
-    m_chargeText.setPosition(m_game.getWindow().getSize().x - 250.f, 50.f);
-
-    m_dashChargesText.setFont(m_hudFont);
-    m_dashChargesText.setCharacterSize(24);
-    m_dashChargesText.setFillColor(sf::Color::Cyan);
-    m_dashChargesText.setPosition(m_game.getWindow().getSize().x - 250.f, 80.f);
-
     // Bottom Laser
     // m_bottomLaser.setSize(sf::Vector2f(static_cast<float>(m_game.getWindow().getSize().x), BOTTOM_LASER_HEIGHT));
     // m_bottomLaser.setFillColor(sf::Color(255, 0, 0, 150)); // Semi-transparent red
@@ -143,104 +239,153 @@ void GameScene::setupInitialState()
     // m_eFieldPositiveText.setFillColor(sf::Color::Red);
     // m_eFieldPositiveText.setString("+ + + E + + +");
 
-    // field random
-    randomizeFields();
-    updateFieldVisuals();
-
-    m_laserSpawnTimer = sf::Time::Zero;
-    m_scrollSpawnTimer = sf::Time::Zero;
-    m_timeBetweenScrollSpawns = sf::seconds(10.f + (m_rng() % 10));
-    m_lasers.clear();
     m_scrollsInScene.clear();
+    m_particles.clear();
+
+    // new course every run, chunk 0 sets the first field zone
+    startLevel(m_rng());
+    m_fieldVisualsValid = false;
+    updateFieldVisuals();
 
     m_physicsEngine.setPlayerMass(1.0f);
 }
 
 void GameScene::handleInput(sf::Event &event, sf::RenderWindow &window)
 {
+    // input applies to the real state, not the one presented
+    leaveRunAhead();
     if (m_isGameOver)
         return;
 
+    // hold R to run time backwards, releasing it continues from there
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::R)
+    {
+        if (!m_rewinding)
+        {
+            startRewind();
+        }
+        return;
+    }
+    if (event.type == sf::Event::KeyReleased && event.key.code == sf::Keyboard::R)
+    {
+        if (m_rewinding)
+        {
+            stopRewind();
+        }
+        return;
+    }
+    if (m_rewinding || m_frozenAtDeath)
+        return;
+
     if (event.type == sf::Event::KeyPressed)
     {
         if (event.key.code == sf::Keyboard::Q)
         {
             m_player->decreaseCharge();
+            emitChargeSparks();
         }
         else if (event.key.code == sf::Keyboard::E)
         {
             m_player->increaseCharge();
+            emitChargeSparks();
         }
         else if (event.key.code == sf::Keyboard::Space)
         {
             m_player->toggleChargeSign();
+            emitChargeSparks();
         }
         else if (event.key.code == sf::Keyboard::W)
         {
-            m_player->dash({0.f, -1.f});
+            emitDash({0.f, -1.f});
         }
         else if (event.key.code == sf::Keyboard::A)
         {
-            m_player->dash({-1.f, 0.f});
+            emitDash({-1.f, 0.f});
         }
         else if (event.key.code == sf::Keyboard::S)
         {
-            m_player->dash({0.f, 1.f});
+            emitDash({0.f, 1.f});
         }
         else if (event.key.code == sf::Keyboard::D)
         {
-            m_player->dash({1.f, 0.f});
+            emitDash({1.f, 0.f});
         }
-        // else if (event.key.code == sf::Keyboard::R) {
-        //     randomizeFields();
-        // }
     }
 }
 
 void GameScene::update(sf::Time deltaTime)
 {
-    if (m_isGameOver)
+    leaveRunAhead();
+    if (m_rewinding)
+    {
+        updateRewind(deltaTime);
+        updateParticles(deltaTime);
+        return;
+    }
+    if (m_isGameOver || m_frozenAtDeath)
         return;
 
-    m_physicsEngine.updatePlayer(*m_player, deltaTime, m_currentFields, m_game.getWindow().getSize());
-    m_player->update(deltaTime);
-
-    updateBackground(deltaTime);
-    m_distanceTraveled += m_bgScrollSpeed * deltaTime.asSeconds() * 0.1f;
+    simulate(deltaTime);
+    updateParticles(deltaTime);
 
-    // spawn
-    m_laserSpawnTimer += deltaTime;
-    if (m_laserSpawnTimer >= m_timeBetweenLaserSpawns)
+    if (m_isGameOver && m_game.getRewindDeaths() && m_rewind.size() > 0)
     {
-        spawnLaser();
-        m_laserSpawnTimer = sf::Time::Zero;
-        // random spawn time
-        std::uniform_real_distribution<float> dist(1.5f, 4.0f);
-        m_timeBetweenLaserSpawns = sf::seconds(dist(m_rng));
+        // debug: hold the fatal frame on screen, R winds back from it
+        m_isGameOver = false;
+        m_frozenAtDeath = true;
+        m_game.getAudioMixer().stopAllSounds();
+        std::cout << "GameScene: died, hold R to rewind" << std::endl;
+        return;
     }
 
-    m_scrollSpawnTimer += deltaTime;
-    if (m_scrollsInScene.size() < m_maxScrollsOnScreen && m_game.getCollectedScrollsCount() < m_game.getTotalScrolls())
+    if (m_isGameOver)
+    {
+        m_game.getMusicService().fadeOut(sf::seconds(0.3f));
+        m_game.playerDied(m_distanceTraveled);
+    }
+    else
     {
-        if (m_scrollSpawnTimer >= m_timeBetweenScrollSpawns)
+        m_game.checkWinCondition(m_distanceTraveled);
+        if (m_game.getCurrentState() == GameState::GameWon)
         {
-            spawnScroll();
-            m_scrollSpawnTimer = sf::Time::Zero;
-            std::uniform_real_distribution<float> dist(8.f, 15.f); // random next scroll spawn
-            m_timeBetweenScrollSpawns = sf::seconds(dist(m_rng));
+            m_isGameOver = true;
         }
     }
 
+    if (!m_isGameOver && recordSnapshot() && m_game.getRunAheadFrames() > 0)
+    {
+        runAhead(deltaTime);
+    }
+}
+
+void GameScene::simulate(sf::Time deltaTime)
+{
+    // the player is carried along with the camera, physics works relative to the scrolling frame
+    float scroll = m_bgScrollSpeed * deltaTime.asSeconds();
+    m_camera.scroll(scroll);
+    m_player->setPosition(m_player->getPosition() + sf::Vector2f(scroll, 0.f));
+    if (m_camera.needsRebase())
+    {
+        rebaseWorld();
+    }
+    {
+        PROFILE_SCOPE("physics");
+        m_physicsEngine.updatePlayer(*m_player, deltaTime, m_currentFields, m_camera.getRect());
+        m_player->update(deltaTime);
+    }
+
+    m_distanceTraveled = static_cast<float>(m_camera.getTravelled() * 0.1);
+
+    updateEvents(deltaTime);
     updateLasers(deltaTime);
-    updateScrolls(deltaTime);
+    updateScrolls();
     updateHUD();
     updateFieldVisuals();
-    for (const auto &laser : m_lasers)
     {
-        if (laser.isActive && m_player->getBounds().intersects(laser.getBounds()))
+        PROFILE_SCOPE("collision");
+        if (checkLaserCollisions())
         {
             m_isGameOver = true;
-            break;
         }
     }
     if (m_player->getPosition().y < -m_player->getBounds().height)
@@ -248,37 +393,191 @@ void GameScene::update(sf::Time deltaTime)
         m_isGameOver = true;
     }
 
-    if (m_isGameOver)
+    if (m_invulnerable)
     {
-        m_gameMusic.stop();
-        m_game.playerDied(m_distanceTraveled);
+        m_isGameOver = false;
     }
-    else
+}
+
+void GameScene::startLevel(std::uint32_t seed)
+{
+    // pending events belong to the old course and the lasers it spawned
+    m_events.clear();
+    m_simTimeUs = 0;
+    clearLasers();
+    stopPatterns();
+    m_rewind.clear();
+    m_events.schedule(PATTERN_RELOAD_TICKS, {GameEventType::ReloadPatterns});
+
+    // unused when a level file is open
+    m_courseSeed = seed;
+    m_chunkX = 0.f;
+    m_chunkStartTick = m_events.now();
+    seekChunk(0);
+    enterChunk();
+}
+
+void GameScene::seekChunk(std::uint32_t index)
+{
+    // a chunk is a pure function of (seed, index) or a fixed place in the level file, so any one can be jumped to
+    m_chunkIndex = index;
+    if (m_levelFile.isOpen())
     {
-        m_game.checkWinCondition(m_distanceTraveled);
-        if (m_game.getCurrentState() == GameState::GameWon)
+        m_hasChunk = m_levelFile.getChunk(index, m_chunk);
+        m_levelFile.prefetch(index + 1, ChunkGenerator::LOOKAHEAD);
+        return;
+    }
+    // this one right here so it is never a gap, the worker takes it from index + 1
+    m_chunkGenerator.start(m_courseSeed, index + 1);
+    m_generatedChunk = ChunkGenerator::generate(m_courseSeed, index);
+    m_chunk = m_generatedChunk.view();
+    m_hasChunk = true;
+}
+
+void GameScene::nextChunk()
+{
+    ++m_chunkIndex;
+    if (m_levelFile.isOpen())
+    {
+        // pages for this one were requested LOOKAHEAD chunks ago, keep the window moving with the camera
+        m_hasChunk = m_levelFile.getChunk(m_chunkIndex, m_chunk);
+        m_levelFile.prefetch(m_chunkIndex + ChunkGenerator::LOOKAHEAD, 1);
+        return;
+    }
+    if (m_speculative)
+    {
+        // the worker's queue belongs to the real timeline, the real frame takes this chunk from it later
+        m_generatedChunk = ChunkGenerator::generate(m_courseSeed, m_chunkIndex);
+        m_chunk = m_generatedChunk.view();
+        m_hasChunk = true;
+        return;
+    }
+    if (!m_chunkGenerator.takeChunk(m_chunkIndex, m_generatedChunk))
+    {
+        // the worker is behind, a gap would make the course differ from what seekChunk rebuilds
+        std::cerr << "GameScene: level chunk " << m_chunkIndex << " not ready, generating it inline" << std::endl;
+        m_generatedChunk = ChunkGenerator::generate(m_courseSeed, m_chunkIndex);
+    }
+    m_chunk = m_generatedChunk.view();
+    m_hasChunk = true;
+}
+
+void GameScene::enterChunk()
+{
+    // the course scrolls at a constant speed, so every spawn in the slice has a known time
+    auto ticksAt = [this](float offset)
+    {
+        double us = static_cast<double>(offset) / m_bgScrollSpeed * 1e6;
+        return m_chunkStartTick + static_cast<std::uint64_t>(std::llround(std::max(0.0, us) / EVENT_TICK_US));
+    };
+    if (m_hasChunk)
+    {
+        if (m_chunk.changesFields)
         {
-            m_isGameOver = true;
+            m_currentFields.electricField = m_chunk.electricField;
+            m_currentFields.magneticField_Z = m_chunk.magneticField_Z;
+        }
+        for (std::uint32_t i = 0; i < m_chunk.laserCount; ++i)
+        {
+            m_events.schedule(ticksAt(m_chunk.laserOffset[i]), {GameEventType::SpawnLaser, m_chunkIndex, i});
+        }
+        for (std::uint32_t i = 0; i < m_chunk.scrollCount; ++i)
+        {
+            m_events.schedule(ticksAt(m_chunk.scrollOffset[i]), {GameEventType::SpawnScroll, m_chunkIndex, i});
+        }
+        for (std::uint32_t i = 0; i < m_chunk.patternCount; ++i)
+        {
+            m_events.schedule(ticksAt(m_chunk.patternOffset[i]), {GameEventType::StartPattern, m_chunkIndex, i});
         }
     }
+    // scheduled last so spawns on the same tick still see this chunk
+    m_events.schedule(ticksAt(LevelChunk::WIDTH), {GameEventType::NextChunk, m_chunkIndex});
 }
 
-void GameScene::updateBackground(sf::Time deltaTime)
+void GameScene::updateEvents(sf::Time deltaTime)
 {
-    float moveDistance = m_bgScrollSpeed * deltaTime.asSeconds();
-    m_backgroundSprite1.move(-moveDistance, 0);
-    m_backgroundSprite2.move(-moveDistance, 0);
+    PROFILE_SCOPE("gameEvents");
+    m_simTimeUs += static_cast<std::uint64_t>(std::max<sf::Int64>(0, deltaTime.asMicroseconds()));
+    m_events.advance(m_simTimeUs / EVENT_TICK_US, [this](const GameEvent &event)
+                     { fireEvent(event); });
+
+    // chunk-local so it never grows large, like the camera
+    m_chunkX = static_cast<float>(static_cast<double>(m_simTimeUs - m_chunkStartTick * EVENT_TICK_US) * 1e-6 * m_bgScrollSpeed);
+
+    // authored chunks can vary the fields across the slice, sampled where the player is
+    FieldProperties sampled;
+    sf::FloatRect view = m_camera.getRect();
+    if (m_hasChunk && m_chunk.sampleFields(m_chunkX / LevelChunk::WIDTH, (m_player->getPosition().y - view.top) / view.height, sampled))
+    {
+        m_currentFields = sampled;
+    }
+}
 
-    float scaledBgWidth = m_gameBgTexture.getSize().x * m_backgroundSprite1.getScale().x;
+void GameScene::fireEvent(const GameEvent &event)
+{
+    switch (event.type)
+    {
+    case GameEventType::SpawnLaser:
+        // a = chunk, events left over from a chunk that's gone are dropped
+        if (m_hasChunk && event.a == m_chunkIndex && event.b < m_chunk.laserCount)
+        {
+            spawnLaser(m_chunk.laser(event.b));
+        }
+        break;
+    case GameEventType::SpawnScroll:
+        if (m_hasChunk && event.a == m_chunkIndex && event.b < m_chunk.scrollCount &&
+            m_scrollsInScene.size() < m_maxScrollsOnScreen && m_game.getCollectedScrollsCount() < m_game.getTotalScrolls())
+        {
+            spawnScroll(m_chunk.scrollY[event.b]);
+        }
+        break;
+    case GameEventType::NextChunk:
+        if (event.a == m_chunkIndex)
+        {
+            // crossed into the next slice, it was generated (or paged in) seconds ago
+            m_chunkStartTick = m_events.now();
+            nextChunk();
+            enterChunk();
+        }
+        break;
+    case GameEventType::DespawnLaser:
+        removeLaser(event.a, event.b);
+        break;
+    case GameEventType::StartPattern:
+        if (m_hasChunk && event.a == m_chunkIndex && event.b < m_chunk.patternCount)
+        {
+            // seeded from the course so a replay gets the same waves
+            startPattern(m_chunk.patternId[event.b], m_chunk.patternId[event.b] ^ (m_chunkIndex * 0x9E3779B9u));
+        }
+        break;
+    case GameEventType::ResumePattern:
+        resumePattern(event.a, event.b);
+        break;
+    case GameEventType::ReloadPatterns:
+        if (!m_speculative && m_patterns.reloadIfChanged())
+        {
+            stopPatterns(); // their program counters point into the old code
+            m_rewind.clear(); // and so do the recorded ones
+        }
+        m_events.schedule(m_events.now() + PATTERN_RELOAD_TICKS, {GameEventType::ReloadPatterns});
+        break;
+    }
+}
 
-    if (m_backgroundSprite1.getPosition().x + scaledBgWidth <= 0)
+void GameScene::rebaseWorld()
+{
+    // floating origin: everything in world space moves together, nothing on screen changes
+    sf::Vector2f shift(m_camera.rebase(), 0.f);
+    m_player->setPosition(m_player->getPosition() + shift);
+    for (auto &laser : m_lasers)
     {
-        m_backgroundSprite1.setPosition(m_backgroundSprite2.getPosition().x + scaledBgWidth, 0);
+        laser.sprite.move(shift);
     }
-    if (m_backgroundSprite2.getPosition().x + scaledBgWidth <= 0)
+    for (auto &scroll : m_scrollsInScene)
     {
-        m_backgroundSprite2.setPosition(m_backgroundSprite1.getPosition().x + scaledBgWidth, 0);
+        scroll.sprite.move(shift);
     }
+    m_particles.translate(shift);
 }
 
 void GameScene::randomizeFields()
@@ -301,16 +600,28 @@ void GameScene::randomizeFields()
     m_currentFields.magneticField_Z = b_dist(m_rng);
 
     // called when spawning laser or on a separate timer
-    std::cout << "Fields randomized: E(" << m_currentFields.electricField.x << "," << m_currentFields.electricField.y
-              << "), B(" << m_currentFields.magneticField_Z << ")" << std::endl;
+    // std::cout << "Fields randomized: E(" << m_currentFields.electricField.x << "," << m_currentFields.electricField.y
+    //           << "), B(" << m_currentFields.magneticField_Z << ")" << std::endl;
 }
 
 void GameScene::updateFieldVisuals()
 {
+    PROFILE_SCOPE("fieldVisuals");
     // std::cout << "GameScene filed visializing. /GameScene.cpp" << std::endl;
     sf::Vector2u windowSize = m_game.getWindow().getSize();
 
-    m_bFieldSymbols.clear();
+    // the symbols only depend on the fields, rebuild when they change
+    if (m_fieldVisualsValid && m_visualizedFields.electricField == m_currentFields.electricField &&
+        m_visualizedFields.magneticField_Z == m_currentFields.magneticField_Z)
+    {
+        return;
+    }
+    m_visualizedFields = m_currentFields;
+    m_fieldVisualsValid = true;
+
+    // refilled within the capacity reserved in loadAssets, so a field change never allocates
+    m_fieldVertices.clear();
+    m_fieldSymbolCount = 0;
 
     // if (std::abs(m_currentFields.magneticField_Z) > 0.05f) { // Only draw if B is significant
     //     std::cout << "B field drawing dots/points. /GameScene.cpp" << std::endl;
@@ -320,11 +631,12 @@ void GameScene::updateFieldVisuals()
 
     if (std::abs(m_currentFields.magneticField_Z) > 0.05f)
     { // only draw if B
-        int numSymbolsTarget = static_cast<int>(std::abs(m_currentFields.magneticField_Z) * B_FIELD_DENSITY_SCALE_FACTOR);
+        int numSymbolsTarget = static_cast<int>(std::abs(m_currentFields.magneticField_Z) * B_FIELD_DENSITY_SCALE_FACTOR * m_bFieldDensityScale);
+        int maxPerRowCol = std::max(1, static_cast<int>(MAX_B_FIELD_SYMBOLS_PER_ROW_COL * std::sqrt(m_bFieldDensityScale)));
 
         // determine grid
         int symbolsPerRow = static_cast<int>(std::sqrt(numSymbolsTarget));
-        symbolsPerRow = std::min(symbolsPerRow, MAX_B_FIELD_SYMBOLS_PER_ROW_COL);
+        symbolsPerRow = std::min(symbolsPerRow, maxPerRowCol);
         symbolsPerRow = std::max(1, symbolsPerRow); // at least 1 if target > 0
         int symbolsPerCol = symbolsPerRow;          // grid
 
@@ -337,37 +649,30 @@ void GameScene::updateFieldVisuals()
         float spacingY = static_cast<float>(windowSize.y) / (symbolsPerCol + 1);
 
         sf::Color bColor = (m_currentFields.magneticField_Z > 0) ? sf::Color(255, 100, 100, 180) : sf::Color(180, 50, 50, 180);
-        std::string symbolChar = (m_currentFields.magneticField_Z > 0) ? "." : "X";
-        unsigned int charSize = (m_currentFields.magneticField_Z > 0) ? 150 : 80;
+        // '.' out of the screen at 150, 'X' into it at 80, both from the FIELD_GLYPH_SIZE page
+        const sf::Glyph &glyph = (m_currentFields.magneticField_Z > 0) ? m_bOutGlyph : m_bInGlyph;
+        float glyphScale = (m_currentFields.magneticField_Z > 0) ? 1.f : 80.f / FIELD_GLYPH_SIZE;
+        sf::Vector2f glyphSize(glyph.bounds.width * glyphScale, glyph.bounds.height * glyphScale);
 
         for (int r = 0; r < symbolsPerCol; ++r)
         {
             for (int c = 0; c < symbolsPerRow; ++c)
             {
-                sf::Text bSymbol;
-                bSymbol.setFont(m_hudFont); // m_hudFont is loaded
-                bSymbol.setString(symbolChar);
-                bSymbol.setCharacterSize(charSize);
-                bSymbol.setFillColor(bColor);
-
-                sf::FloatRect textRect = bSymbol.getLocalBounds();
-                bSymbol.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
-                bSymbol.setPosition((c + 1) * spacingX, (r + 1) * spacingY);
-                m_bFieldSymbols.push_back(bSymbol);
+                // centred on the grid point, like the old sf::Text with its origin at the bounds centre
+                sf::Vector2f center((c + 1) * spacingX, (r + 1) * spacingY);
+                addFieldQuad(center - glyphSize / 2.f, center + glyphSize / 2.f, bColor, sf::FloatRect(glyph.textureRect));
+                ++m_fieldSymbolCount;
             }
         }
     }
 
     // E Field
-    m_eFieldLines.clear();
     if (std::abs(m_currentFields.electricField.x) > 1.0f || std::abs(m_currentFields.electricField.y) > 1.0f)
     {
         // std::cout << "drawing E field arrows. /GameScene.cpp" << std::endl;
-        int numLines = 5;
-        for (int i = 0; i < numLines; ++i)
+        for (int i = 0; i < E_FIELD_LINES; ++i)
         {
-            float yPos = (windowSize.y / (numLines + 1)) * (i + 1);
-            sf::VertexArray line(sf::Lines, 2);
+            float yPos = (windowSize.y / (E_FIELD_LINES + 1)) * (i + 1);
             sf::Vector2f startPos, endPos;
             float arrowSize = 10.f;
 
@@ -375,133 +680,324 @@ void GameScene::updateFieldVisuals()
             {
                 startPos = {PADDING * 5, yPos};
                 endPos = {windowSize.x - PADDING * 5, yPos};
-                line[0].position = startPos;
-                line[1].position = endPos;
-                line[0].color = sf::Color::Cyan;
-                line[1].color = sf::Color::Cyan;
-                m_eFieldLines.push_back(line);
+                // the line is a thin quad so it can share the draw call with the glyphs
+                addFieldQuad({startPos.x, yPos - E_FIELD_LINE_WIDTH / 2.f}, {endPos.x, yPos + E_FIELD_LINE_WIDTH / 2.f}, sf::Color::Cyan);
 
-                sf::VertexArray arrowhead(sf::Triangles, 3);
+                // arrowhead, a quad with its last corner on the tip folds into a triangle
+                sf::Vector2f tip = startPos;
+                float back = arrowSize;
                 if (m_currentFields.electricField.x > 0)
                 { // point right
-                    arrowhead[0].position = {endPos.x, endPos.y};
-                    arrowhead[1].position = {endPos.x - arrowSize, endPos.y - arrowSize / 2.f};
-                    arrowhead[2].position = {endPos.x - arrowSize, endPos.y + arrowSize / 2.f};
-                }
-                else
-                { // point left
-                    arrowhead[0].position = {startPos.x, startPos.y};
-                    arrowhead[1].position = {startPos.x + arrowSize, startPos.y - arrowSize / 2.f};
-                    arrowhead[2].position = {startPos.x + arrowSize, startPos.y + arrowSize / 2.f};
+                    tip = endPos;
+                    back = -arrowSize;
                 }
-                arrowhead[0].color = sf::Color::Cyan;
-                arrowhead[1].color = sf::Color::Cyan;
-                arrowhead[2].color = sf::Color::Cyan;
-                m_eFieldLines.push_back(arrowhead);
+                sf::Vector2f whiteTexel(1.f, 1.f);
+                m_fieldVertices.emplace_back(tip, sf::Color::Cyan, whiteTexel);
+                m_fieldVertices.emplace_back(sf::Vector2f(tip.x + back, tip.y - arrowSize / 2.f), sf::Color::Cyan, whiteTexel);
+                m_fieldVertices.emplace_back(sf::Vector2f(tip.x + back, tip.y + arrowSize / 2.f), sf::Color::Cyan, whiteTexel);
+                m_fieldVertices.emplace_back(tip, sf::Color::Cyan, whiteTexel);
             }
         }
     }
 }
 
-void GameScene::spawnLaser()
+void GameScene::addFieldQuad(sf::Vector2f topLeft, sf::Vector2f bottomRight, sf::Color color, sf::FloatRect textureRect)
+{
+    float u0 = textureRect.left;
+    float v0 = textureRect.top;
+    float u1 = u0 + textureRect.width;
+    float v1 = v0 + textureRect.height;
+    m_fieldVertices.emplace_back(topLeft, color, sf::Vector2f(u0, v0));
+    m_fieldVertices.emplace_back(sf::Vector2f(bottomRight.x, topLeft.y), color, sf::Vector2f(u1, v0));
+    m_fieldVertices.emplace_back(bottomRight, color, sf::Vector2f(u1, v1));
+    m_fieldVertices.emplace_back(sf::Vector2f(topLeft.x, bottomRight.y), color, sf::Vector2f(u0, v1));
+}
+
+void GameScene::spawnLaser(const LaserSpawn &spawn)
 {
+    PROFILE_SCOPE("spawnLaser");
     // std::cout << "sapwn laser. /GameScene.cpp" << std::endl;
-    if (m_laserTexture.getSize().x == 0)
+    if (m_laserRegion.width == 0)
     {
-        std::cout << "ERROR! m_laserTexture invalid!" << std::endl;
+        std::cout << "ERROR! laser atlas region invalid!" << std::endl;
         return;
     }
-    std::uniform_int_distribution<int> side_dist(0, 3); // 0:top, 1:bottom, 2:left, 3:right
-    int side = side_dist(m_rng);
-
     sf::Vector2f laserSize;
     sf::Vector2f laserPos;
     sf::Vector2f laserVel;
-    float laserSpeed = 150.f + (m_rng() % 200); // random speed
+    float laserSpeed = spawn.speed;
     float rotation = 0.f;
     sf::Vector2u winSize = m_game.getWindow().getSize();
 
     float scaledHeight = 15.f;
 
-    switch (side)
+    float alongX = spawn.along * static_cast<float>(winSize.x);
+    float alongY = spawn.along * static_cast<float>(winSize.y);
+
+    switch (spawn.side)
     {
-    case 0: // From Top
+    case LaserSide::Top:
         // laserSize = sf::Vector2f(static_cast<float>(5 + m_rng() % 15), static_cast<float>(50 + m_rng() % 100));
         // laserPos = sf::Vector2f(static_cast<float>(m_rng() % winSize.x), -laserSize.y);
         // laserVel = sf::Vector2f(0, laserSpeed);
-        laserPos = {static_cast<float>(m_rng() % winSize.x), -scaledHeight / 2.f};
+        laserPos = {alongX, -scaledHeight / 2.f};
         laserVel = {0, laserSpeed};
         rotation = 90.f;
-        std::cout << "Spawned a laser from top." << std::endl;
+        // std::cout << "Spawned a laser from top." << std::endl;
         break;
-    case 1: // From Bottom
+    case LaserSide::Bottom:
         // laserSize = sf::Vector2f(static_cast<float>(5 + m_rng() % 15), static_cast<float>(50 + m_rng() % 100));
         // laserPos = sf::Vector2f(static_cast<float>(m_rng() % winSize.x), static_cast<float>(winSize.y));
         // laserVel = sf::Vector2f(0, -laserSpeed);
-        laserPos = {static_cast<float>(m_rng() % winSize.x), static_cast<float>(winSize.y) + scaledHeight / 2.f};
+        laserPos = {alongX, static_cast<float>(winSize.y) + scaledHeight / 2.f};
         laserVel = {0, -laserSpeed};
         rotation = -90.f;
-        std::cout << "Spawned a laser from bottom." << std::endl;
+        // std::cout << "Spawned a laser from bottom." << std::endl;
         break;
-    case 2: // From Left
+    case LaserSide::Left:
         // laserSize = sf::Vector2f(static_cast<float>(50 + m_rng() % 100), static_cast<float>(5 + m_rng() % 15));
         // laserPos = sf::Vector2f(-laserSize.x, static_cast<float>(m_rng() % winSize.y));
         // laserVel = sf::Vector2f(laserSpeed, 0);
-        laserPos = {-scaledHeight / 2.f, static_cast<float>(m_rng() % winSize.y)};
+        laserPos = {-scaledHeight / 2.f, alongY};
         laserVel = {laserSpeed, 0};
         rotation = 0.f;
-        std::cout << "Spawned a laser from left." << std::endl;
+        // std::cout << "Spawned a laser from left." << std::endl;
         break;
-    case 3: // From Right
+    case LaserSide::Right:
         // laserSize = sf::Vector2f(static_cast<float>(50 + m_rng() % 100), static_cast<float>(5 + m_rng() % 15));
         // laserPos = sf::Vector2f(static_cast<float>(winSize.x), static_cast<float>(m_rng() % winSize.y));
         // laserVel = sf::Vector2f(-laserSpeed, 0);
-        laserPos = {static_cast<float>(winSize.x) + scaledHeight / 2.f, static_cast<float>(m_rng() % winSize.y)};
+        laserPos = {static_cast<float>(winSize.x) + scaledHeight / 2.f, alongY};
         laserVel = {-laserSpeed, 0};
         rotation = 180.f;
-        std::cout << "Spawned a laser from right." << std::endl;
+        // std::cout << "Spawned a laser from right." << std::endl;
         break;
     }
-    m_lasers.emplace_back(m_laserTexture, laserPos, laserVel, rotation);
+    addLaser(laserPos, laserVel, rotation);
+    playLaserSound(laserPos.x);
+}
 
-    m_laserSound.play();
+void GameScene::playLaserSound(float screenX)
+{
+    if (m_laserSoundBuffer && !m_speculative)
+    {
+        // rapid spawns overlap instead of restarting one sf::Sound, panned towards where the laser enters
+        VoiceParams voice;
+        voice.gain = 0.5f;
+        voice.pan = screenX / static_cast<float>(m_game.getWindow().getSize().x) * 2.f - 1.f;
+        m_game.getAudioMixer().playSound(*m_laserSoundBuffer, voice);
+    }
+}
 
-    if (m_rng() % 3 == 0)
-    { // 1/3 change f
-        randomizeFields();
+void GameScene::startPattern(std::uint32_t pattern, std::uint32_t seed)
+{
+    if (!m_patterns.isLoaded() || m_freePatternSlots.empty())
+    {
+        return;
+    }
+    std::uint32_t slot = m_freePatternSlots.back();
+    m_freePatternSlots.pop_back();
+    PatternInstance &instance = m_patternInstances[slot];
+    PatternScript::start(m_patterns.getProgram(), pattern, seed, instance.state);
+    instance.startTick = m_events.now();
+    instance.isActive = true;
+    resumePattern(slot, instance.generation);
+}
+
+void GameScene::resumePattern(std::uint32_t slot, std::uint32_t generation)
+{
+    if (slot >= m_patternInstances.size() || !m_patternInstances[slot].isActive ||
+        m_patternInstances[slot].generation != generation)
+    {
+        return; // stopped or reloaded since the wait was scheduled
+    }
+    PatternInstance &instance = m_patternInstances[slot];
+    PatternEnv env;
+    env.time = static_cast<float>(m_events.now() - instance.startTick) * (EVENT_TICK_US * 1e-6f);
+    env.fields = m_currentFields;
+    float wait = PatternScript::run(m_patterns.getProgram(), instance.state, env, [this](const PatternShot &shot)
+                                    { firePatternShot(shot); });
+    if (wait < 0.f)
+    {
+        instance.isActive = false;
+        ++instance.generation;
+        m_freePatternSlots.push_back(slot);
+        return;
+    }
+    auto ticks = static_cast<std::uint64_t>(std::ceil(wait * 1e6 / EVENT_TICK_US));
+    m_events.schedule(m_events.now() + std::max<std::uint64_t>(1, ticks), {GameEventType::ResumePattern, slot, generation});
+}
+
+void GameScene::stopPatterns()
+{
+    m_freePatternSlots.clear();
+    for (std::uint32_t slot = static_cast<std::uint32_t>(m_patternInstances.size()); slot-- > 0;)
+    {
+        PatternInstance &instance = m_patternInstances[slot];
+        instance.isActive = false;
+        ++instance.generation; // pending resumes won't match
+        m_freePatternSlots.push_back(slot);
+    }
+}
+
+void GameScene::firePatternShot(const PatternShot &shot)
+{
+    if (shot.fromEdge)
+    {
+        LaserSpawn spawn;
+        spawn.side = shot.side;
+        spawn.along = std::max(0.f, std::min(shot.along, 1.f));
+        spawn.speed = shot.speed;
+        spawnLaser(spawn);
+        return;
+    }
+    sf::Vector2f winSize(m_game.getWindow().getSize());
+    sf::Vector2f pos(shot.position.x * winSize.x, shot.position.y * winSize.y);
+    float radians = shot.angle * 3.14159265f / 180.f;
+    addLaser(pos, sf::Vector2f(std::cos(radians), std::sin(radians)) * shot.speed, shot.angle);
+    playLaserSound(pos.x);
+}
+
+void GameScene::addLaser(sf::Vector2f screenPos, sf::Vector2f screenVelocity, float rotation)
+{
+    std::uint32_t slot;
+    if (!m_freeLaserSlots.empty())
+    {
+        slot = m_freeLaserSlots.back();
+        m_freeLaserSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(m_laserIndexBySlot.size());
+        m_laserIndexBySlot.push_back(0);
+        m_laserSlotGeneration.push_back(0);
+    }
+    m_laserIndexBySlot[slot] = static_cast<std::uint32_t>(m_lasers.size());
+
+    // patterns are authored against the screen, keep them moving relative to it
+    m_lasers.emplace_back(m_atlas.getTexture(), m_laserRegion, m_camera.screenToWorld(screenPos),
+                          screenVelocity + sf::Vector2f(m_bgScrollSpeed, 0.f), rotation);
+    m_lasers.back().slot = slot;
+
+    // relative to the camera it moves in a straight line at screenVelocity, so the frame it is
+    // fully off screen is known now. one that doesn't move on screen stays until the course resets
+    sf::FloatRect bounds = m_lasers.back().getBounds();
+    sf::FloatRect view = m_camera.getRect();
+    float exitSeconds = std::numeric_limits<float>::max();
+    if (screenVelocity.x > 0.f)
+        exitSeconds = std::min(exitSeconds, (view.left + view.width - bounds.left) / screenVelocity.x);
+    else if (screenVelocity.x < 0.f)
+        exitSeconds = std::min(exitSeconds, (bounds.left + bounds.width - view.left) / -screenVelocity.x);
+    if (screenVelocity.y > 0.f)
+        exitSeconds = std::min(exitSeconds, (view.top + view.height - bounds.top) / screenVelocity.y);
+    else if (screenVelocity.y < 0.f)
+        exitSeconds = std::min(exitSeconds, (bounds.top + bounds.height - view.top) / -screenVelocity.y);
+    if (exitSeconds < std::numeric_limits<float>::max())
+    {
+        auto ticks = static_cast<std::uint64_t>(std::ceil(std::max(0.f, exitSeconds) * 1e6 / EVENT_TICK_US));
+        m_events.schedule(m_events.now() + ticks, {GameEventType::DespawnLaser, slot, m_laserSlotGeneration[slot]});
+    }
+}
+
+void GameScene::removeLaser(std::uint32_t slot, std::uint32_t generation)
+{
+    if (slot >= m_laserSlotGeneration.size() || m_laserSlotGeneration[slot] != generation)
+    {
+        return; // already gone, the slot was cleared or reused
+    }
+    // swap and pop, only the moved laser's slot needs fixing
+    std::uint32_t index = m_laserIndexBySlot[slot];
+    if (index + 1 != m_lasers.size())
+    {
+        m_lasers[index] = std::move(m_lasers.back());
+        m_laserIndexBySlot[m_lasers[index].slot] = index;
+    }
+    m_lasers.pop_back();
+    ++m_laserSlotGeneration[slot];
+    m_freeLaserSlots.push_back(slot);
+}
+
+void GameScene::clearLasers()
+{
+    m_lasers.clear();
+    m_freeLaserSlots.clear();
+    for (std::uint32_t slot = static_cast<std::uint32_t>(m_laserSlotGeneration.size()); slot-- > 0;)
+    {
+        ++m_laserSlotGeneration[slot]; // pending despawns for the old lasers won't match
+        m_freeLaserSlots.push_back(slot);
     }
 }
 
 void GameScene::updateLasers(sf::Time deltaTime)
 {
-    sf::Vector2u winSize = m_game.getWindow().getSize();
+    PROFILE_SCOPE("lasers");
+    // leaving the screen is a DespawnLaser event scheduled at spawn, nothing to check here
     for (auto &laser : m_lasers)
     {
-        if (laser.isActive)
+        laser.update(deltaTime);
+    }
+}
+
+void GameScene::updateParticles(sf::Time deltaTime)
+{
+    PROFILE_SCOPE("particles");
+    if (!m_rewinding)
+    {
+        // trails come off the back end of each laser on screen
+        float trailCount = LASER_TRAIL_RATE * deltaTime.asSeconds();
+        sf::FloatRect view = m_camera.getRect();
+        for (const auto &laser : m_lasers)
         {
-            laser.update(deltaTime);
-            sf::FloatRect bounds = laser.getBounds();
-            if (bounds.left > winSize.x || bounds.left + bounds.width < 0 ||
-                bounds.top > winSize.y || bounds.top + bounds.height < 0)
+            if (laser.isActive && view.intersects(laser.getBounds()))
             {
-                laser.isActive = false;
+                sf::Vector2f tail = laser.sprite.getTransform().transformPoint(0.f, m_laserRegion.height / 2.f);
+                m_particles.emit(LASER_TRAIL, tail, -laser.velocity, trailCount);
             }
         }
     }
-    // remove laser
-    m_lasers.erase(std::remove_if(m_lasers.begin(), m_lasers.end(),
-                                  [](const Laser &l)
-                                  { return !l.isActive; }),
-                   m_lasers.end());
+    m_particles.update(deltaTime.asSeconds());
 }
 
-void GameScene::spawnScroll()
+void GameScene::emitDash(sf::Vector2f direction)
 {
+    sf::Vector2f from = m_player->getPosition();
+    int chargesBefore = m_player->getDashCharges();
+    m_player->dash(direction);
+    if (m_player->getDashCharges() < chargesBefore)
+    {
+        // blown out behind where the player was
+        m_particles.emit(DASH_BURST, from, -direction, DASH_BURST_COUNT);
+    }
+}
+
+void GameScene::emitChargeSparks()
+{
+    const ParticleEmitter &spark = m_player->getCharge() >= 0.f ? POSITIVE_SPARK : NEGATIVE_SPARK;
+    m_particles.emit(spark, m_player->getPosition(), {0.f, -1.f}, CHARGE_SPARK_COUNT);
+}
+
+bool GameScene::checkLaserCollisions() const
+{
+    sf::FloatRect playerBounds = m_player->getBounds();
+    for (const auto &laser : m_lasers)
+    {
+        if (laser.isActive && playerBounds.intersects(laser.getBounds()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameScene::spawnScroll(float yFraction)
+{
+    PROFILE_SCOPE("spawnScroll");
     if (m_game.getCollectedScrollsCount() >= m_game.getTotalScrolls())
         return; // all scrolls collected
 
     // ID that hasn't been collected yet and isn't currently in scene
-    std::vector<int> availableScrollIds;
+    std::pmr::vector<int> availableScrollIds(&m_game.getFrameArena());
+    availableScrollIds.reserve(m_game.getTotalScrolls());
     for (int i = 0; i < m_game.getTotalScrolls(); ++i)
     {
         if (!m_game.isScrollCollected(i))
@@ -529,29 +1025,33 @@ void GameScene::spawnScroll()
     int scrollIdToSpawn = availableScrollIds[id_dist(m_rng)];
 
     sf::Vector2u winSize = m_game.getWindow().getSize();
-    float spawnY = static_cast<float>(m_rng() % (winSize.y - 100) + 50);
-    sf::Vector2f spawnPos = {static_cast<float>(winSize.x) + 50.f, spawnY};
+    float spawnY = 50.f + yFraction * static_cast<float>(winSize.y - 100);
+    sf::Vector2f spawnPos = m_camera.screenToWorld({static_cast<float>(winSize.x) + 50.f, spawnY});
 
-    m_scrollsInScene.emplace_back(scrollIdToSpawn, m_scrollItemTexture, spawnPos);
+    m_scrollsInScene.emplace_back(scrollIdToSpawn, m_atlas.getTexture(), m_scrollRegion, spawnPos);
     std::cout << "Spawned scroll ID: " << scrollIdToSpawn << std::endl;
 }
 
-void GameScene::updateScrolls(sf::Time deltaTime)
+void GameScene::updateScrolls()
 {
-    float moveDistance = m_bgScrollSpeed * deltaTime.asSeconds();
+    PROFILE_SCOPE("scrolls");
+    // scrolls sit still in the world, the camera passes them
+    float cameraLeft = m_camera.getRect().left;
 
     for (auto &scroll : m_scrollsInScene)
     {
         if (scroll.isActive)
         {
-            scroll.sprite.move(-moveDistance, 0);
             // check collection
             if (scroll.getBounds().intersects(m_player->getBounds()))
             {
-                m_game.collectScroll(scroll.id);
+                if (!m_speculative)
+                {
+                    m_game.collectScroll(scroll.id);
+                }
                 scroll.isActive = false;
             }
-            if (scroll.sprite.getPosition().x + scroll.getBounds().width < 0)
+            if (scroll.sprite.getPosition().x + scroll.getBounds().width < cameraLeft)
             {
                 scroll.isActive = false;
             }
@@ -564,74 +1064,415 @@ void GameScene::updateScrolls(sf::Time deltaTime)
                            m_scrollsInScene.end());
 }
 
+bool GameScene::captureSnapshot(GameSnapshot &snapshot) const
+{
+    PROFILE_SCOPE("snapshot");
+    if (m_lasers.size() > GameSnapshot::MAX_LASERS || m_scrollsInScene.size() > GameSnapshot::MAX_SCROLLS ||
+        m_events.size() > GameSnapshot::MAX_EVENTS)
+    {
+        return false;
+    }
+
+    snapshot.simTimeUs = m_simTimeUs;
+    snapshot.eventTick = m_events.now();
+    snapshot.chunkStartTick = m_chunkStartTick;
+
+    snapshot.cameraRebased = m_camera.getRebasedDistance();
+    snapshot.cameraLeft = m_camera.getLeft();
+
+    snapshot.playerX = m_player->getPosition().x;
+    snapshot.playerY = m_player->getPosition().y;
+    snapshot.playerVX = m_player->getVelocity().x;
+    snapshot.playerVY = m_player->getVelocity().y;
+    snapshot.playerCharge = m_player->getCharge();
+    snapshot.dashCharges = m_player->getDashCharges();
+
+    snapshot.electricX = m_currentFields.electricField.x;
+    snapshot.electricY = m_currentFields.electricField.y;
+    snapshot.magneticZ = m_currentFields.magneticField_Z;
+    snapshot.courseSeed = m_courseSeed;
+    snapshot.chunkIndex = m_chunkIndex;
+    snapshot.hasChunk = m_hasChunk ? 1 : 0;
+
+    snapshot.laserCount = static_cast<std::uint32_t>(m_lasers.size());
+    for (std::size_t i = 0; i < m_lasers.size(); ++i)
+    {
+        const Laser &laser = m_lasers[i];
+        snapshot.lasers[i] = {laser.sprite.getPosition().x, laser.sprite.getPosition().y,
+                              laser.velocity.x, laser.velocity.y, laser.sprite.getRotation(),
+                              laser.slot, m_laserSlotGeneration[laser.slot], 0};
+    }
+
+    snapshot.scrollCount = 0;
+    for (const auto &scroll : m_scrollsInScene)
+    {
+        if (scroll.isActive)
+        {
+            snapshot.scrolls[snapshot.scrollCount++] = {scroll.sprite.getPosition().x, scroll.sprite.getPosition().y, scroll.id, 0};
+        }
+    }
+
+    // the wheel's internal order depends on when things were scheduled, sort so same-tick events
+    // refire in a fixed order and unchanged frames diff to nothing
+    snapshot.eventCount = 0;
+    m_events.forEach([&snapshot](std::uint64_t due, const GameEvent &event)
+                     { snapshot.events[snapshot.eventCount++] = {due, static_cast<std::uint32_t>(event.type), event.a, event.b, 0}; });
+    std::sort(snapshot.events, snapshot.events + snapshot.eventCount,
+              [](const GameSnapshot::EventRecord &l, const GameSnapshot::EventRecord &r)
+              {
+                  if (l.due != r.due)
+                      return l.due < r.due;
+                  if (l.type != r.type)
+                      return l.type < r.type;
+                  return l.a != r.a ? l.a < r.a : l.b < r.b;
+              });
+
+    snapshot.patternCount = 0;
+    for (std::uint32_t slot = 0; slot < m_patternInstances.size(); ++slot)
+    {
+        const PatternInstance &instance = m_patternInstances[slot];
+        if (!instance.isActive)
+        {
+            continue;
+        }
+        if (snapshot.patternCount == GameSnapshot::MAX_PATTERNS)
+        {
+            return false;
+        }
+        GameSnapshot::PatternRecord &record = snapshot.patterns[snapshot.patternCount++];
+        record.startTick = instance.startTick;
+        record.slot = slot;
+        record.generation = instance.generation;
+        record.state = instance.state;
+    }
+
+    std::memcpy(snapshot.rng, &m_rng, sizeof(m_rng));
+    return true;
+}
+
+void GameScene::restoreSnapshot(const GameSnapshot &snapshot)
+{
+    m_simTimeUs = snapshot.simTimeUs;
+    // particles aren't in the snapshot, but a rebase crossed by the restore still moves their frame
+    double rebasedBefore = m_camera.getRebasedDistance();
+    m_camera.restore(snapshot.cameraLeft, snapshot.cameraRebased);
+    if (rebasedBefore != snapshot.cameraRebased)
+    {
+        m_particles.translate({static_cast<float>(rebasedBefore - snapshot.cameraRebased), 0.f});
+    }
+
+    m_player->setPosition({snapshot.playerX, snapshot.playerY});
+    m_player->setVelocity({snapshot.playerVX, snapshot.playerVY});
+    m_player->setCharge(snapshot.playerCharge);
+    m_player->setDashCharges(snapshot.dashCharges);
+
+    m_currentFields.electricField = {snapshot.electricX, snapshot.electricY};
+    m_currentFields.magneticField_Z = snapshot.magneticZ;
+    if (snapshot.courseSeed != m_courseSeed || snapshot.chunkIndex != m_chunkIndex)
+    {
+        m_courseSeed = snapshot.courseSeed;
+        seekChunk(snapshot.chunkIndex);
+    }
+    m_hasChunk = snapshot.hasChunk != 0;
+    m_chunkStartTick = snapshot.chunkStartTick;
+    m_chunkX = static_cast<float>(static_cast<double>(m_simTimeUs - m_chunkStartTick * EVENT_TICK_US) * 1e-6 * m_bgScrollSpeed);
+
+    // lasers keep their slots and generations so the recorded despawns still match them,
+    // every other slot is bumped and freed
+    m_lasers.clear();
+    for (auto &generation : m_laserSlotGeneration)
+    {
+        ++generation;
+    }
+    for (std::uint32_t i = 0; i < snapshot.laserCount; ++i)
+    {
+        const GameSnapshot::LaserRecord &record = snapshot.lasers[i];
+        m_lasers.emplace_back(m_atlas.getTexture(), m_laserRegion, sf::Vector2f(record.x, record.y), sf::Vector2f(record.vx, record.vy), record.rotation);
+        m_lasers.back().slot = record.slot;
+        m_laserIndexBySlot[record.slot] = i;
+        m_laserSlotGeneration[record.slot] = record.generation;
+    }
+    m_freeLaserSlots.clear();
+    for (std::uint32_t slot = static_cast<std::uint32_t>(m_laserIndexBySlot.size()); slot-- > 0;)
+    {
+        std::uint32_t index = m_laserIndexBySlot[slot];
+        if (index >= m_lasers.size() || m_lasers[index].slot != slot)
+        {
+            m_freeLaserSlots.push_back(slot);
+        }
+    }
+
+    // collected scrolls belong to Game and stay collected
+    m_scrollsInScene.clear();
+    for (std::uint32_t i = 0; i < snapshot.scrollCount; ++i)
+    {
+        const GameSnapshot::ScrollRecord &record = snapshot.scrolls[i];
+        if (!m_game.isScrollCollected(record.id))
+        {
+            m_scrollsInScene.emplace_back(record.id, m_atlas.getTexture(), m_scrollRegion, sf::Vector2f(record.x, record.y));
+        }
+    }
+
+    // same for pattern slots
+    for (auto &instance : m_patternInstances)
+    {
+        instance.isActive = false;
+        ++instance.generation;
+    }
+    for (std::uint32_t i = 0; i < snapshot.patternCount; ++i)
+    {
+        const GameSnapshot::PatternRecord &record = snapshot.patterns[i];
+        PatternInstance &instance = m_patternInstances[record.slot];
+        instance.state = record.state;
+        instance.startTick = record.startTick;
+        instance.generation = record.generation;
+        instance.isActive = true;
+    }
+    m_freePatternSlots.clear();
+    for (std::uint32_t slot = static_cast<std::uint32_t>(m_patternInstances.size()); slot-- > 0;)
+    {
+        if (!m_patternInstances[slot].isActive)
+        {
+            m_freePatternSlots.push_back(slot);
+        }
+    }
+
+    m_events.clear(snapshot.eventTick);
+    for (std::uint32_t i = 0; i < snapshot.eventCount; ++i)
+    {
+        const GameSnapshot::EventRecord &record = snapshot.events[i];
+        m_events.schedule(record.due, {static_cast<GameEventType>(record.type), record.a, record.b});
+    }
+
+    std::memcpy(&m_rng, snapshot.rng, sizeof(m_rng));
+    m_distanceTraveled = static_cast<float>(m_camera.getTravelled() * 0.1);
+    updateHUD();
+    updateFieldVisuals();
+}
+
+// true if m_snapshot now holds the current state
+bool GameScene::recordSnapshot()
+{
+    if (!captureSnapshot(m_snapshot))
+    {
+        // more on screen than a snapshot holds (stress benchmarks), the history would have a hole
+        m_rewind.clear();
+        return false;
+    }
+    m_rewind.push(m_snapshot, m_simTimeUs);
+    if (m_simTimeUs > REWIND_WINDOW_US)
+    {
+        m_rewind.dropBefore(m_simTimeUs - REWIND_WINDOW_US);
+    }
+    return true;
+}
+
+void GameScene::runAhead(sf::Time deltaTime)
+{
+    PROFILE_SCOPE("runAhead");
+    // m_snapshot was just captured from the real state and is what leaveRunAhead restores
+    m_runAheadChunk = m_generatedChunk;
+    m_runAheadView = m_chunk;
+    m_speculative = true;
+    for (int frame = 0; frame < m_game.getRunAheadFrames() && !m_isGameOver; ++frame)
+    {
+        simulate(deltaTime);
+    }
+    // a speculative death is only shown, the real frame decides
+    m_isGameOver = false;
+}
+
+void GameScene::leaveRunAhead()
+{
+    if (!m_speculative)
+    {
+        return;
+    }
+    PROFILE_SCOPE("runAhead");
+    m_speculative = false;
+    if (m_chunkIndex != m_snapshot.chunkIndex)
+    {
+        // crossed a chunk speculatively, put the real one back without restarting the worker
+        m_generatedChunk = m_runAheadChunk;
+        m_chunk = m_runAheadView;
+        m_chunkIndex = m_snapshot.chunkIndex;
+    }
+    restoreSnapshot(m_snapshot);
+}
+
+void GameScene::startRewind()
+{
+    if (m_rewind.size() == 0)
+    {
+        return;
+    }
+    m_rewinding = true;
+    m_rewindCursorUs = m_simTimeUs;
+    m_rewindIndex = RewindBuffer<GameSnapshot>::NONE;
+    m_game.getAudioMixer().stopAllSounds();
+}
+
+void GameScene::updateRewind(sf::Time deltaTime)
+{
+    PROFILE_SCOPE("rewind");
+    // back at the speed time went forwards, stops at the oldest snapshot
+    auto step = static_cast<std::uint64_t>(std::max<sf::Int64>(0, deltaTime.asMicroseconds()));
+    std::uint64_t oldest = m_rewind.getStamp(0);
+    m_rewindCursorUs = m_rewindCursorUs > oldest + step ? m_rewindCursorUs - step : oldest;
+
+    std::size_t index = m_rewind.findAtOrBefore(m_rewindCursorUs);
+    if (index != RewindBuffer<GameSnapshot>::NONE && index != m_rewindIndex)
+    {
+        m_rewind.restore(index, m_snapshot);
+        restoreSnapshot(m_snapshot);
+        m_rewindIndex = index;
+    }
+}
+
+void GameScene::stopRewind()
+{
+    m_rewinding = false;
+    if (m_rewindIndex == RewindBuffer<GameSnapshot>::NONE)
+    {
+        return; // released before anything was restored
+    }
+    // the future that was rewound over is gone, recording continues from here
+    m_rewind.truncateAfter(m_rewindIndex);
+    m_frozenAtDeath = false;
+}
+
 void GameScene::updateHUD()
 {
+    PROFILE_SCOPE("hud");
     if (!m_player)
         return;
-    m_distanceText.setString("Distance: " + std::to_string(static_cast<int>(m_distanceTraveled)));
-
-    std::string chargeStr = "Charge: " + std::to_string(m_player->getCharge());
-    char buffer[10];
-    std::snprintf(buffer, sizeof(buffer), "%.1f", m_player->getCharge());
-    m_chargeText.setString("Charge: " + std::string(buffer));
+    m_hud.setValue(m_distanceField, static_cast<float>(static_cast<int>(m_distanceTraveled)));
+    m_hud.setValue(m_chargeField, m_player->getCharge());
+    m_hud.setValue(m_dashChargesField, static_cast<float>(m_player->getDashCharges()));
+}
 
-    m_dashChargesText.setString("Dash: " + std::to_string(m_player->getDashCharges()));
+std::size_t GameScene::getDebugCounters(DebugCounter *out, std::size_t capacity) const
+{
+    std::size_t activePatterns = m_patternInstances.size() - m_freePatternSlots.size();
+    const DebugCounter counters[] = {
+        {"lasers", m_lasers.size()},
+        {"laserSlots", m_laserSlotGeneration.size()},
+        {"scrolls", m_scrollsInScene.size()},
+        {"patterns", activePatterns},
+        {"events", m_events.size()},
+        {"chunk", m_chunkIndex},
+        {"rewindRecords", m_rewind.size()},
+        {"rewindBytes", m_rewind.getUsedBytes()},
+        {"fieldSymbols", m_fieldSymbolCount},
+        {"particles", m_particles.getCount()},
+        {"particlesDropped", m_particles.getDropped()},
+        {"particleEmitPct", static_cast<std::size_t>(m_particles.getEmitScale() * 100.f)},
+    };
+    std::size_t count = std::min(capacity, sizeof(counters) / sizeof(counters[0]));
+    std::copy(counters, counters + count, out);
+    return count;
 }
 
-void GameScene::render(sf::RenderWindow &window)
+float GameScene::getRenderScale() const
 {
-    window.clear(sf::Color(10, 10, 20));
+    float scale = m_game.getRenderScale() * m_game.getQualityGovernor().getSettings().renderScale;
+    return std::max(Game::MIN_RENDER_SCALE, std::min(1.f, scale));
+}
 
-    // Background
-    window.draw(m_backgroundSprite1);
-    window.draw(m_backgroundSprite2);
+void GameScene::render(InstrumentedRenderTarget &target)
+{
+    float scale = getRenderScale();
+    if (scale < 1.f && !m_worldTextureFailed && m_worldTexture.getSize() != target.getSize())
+    {
+        // window sized once, lower scales only use part of it so the governor can change it freely
+        m_worldTextureFailed = !m_worldTexture.create(target.getSize().x, target.getSize().y);
+        m_worldTexture.setSmooth(true);
+        if (m_worldTextureFailed)
+        {
+            std::cerr << "GameScene: no render texture, rendering at full resolution" << std::endl;
+        }
+    }
 
-    // Field Visual
-    for (const auto &line : m_eFieldLines)
+    if (scale >= 1.f || m_worldTextureFailed)
     {
-        window.draw(line);
+        renderWorld(target);
     }
+    else
+    {
+        // fill rate goes with the pixel count, the world is drawn smaller and stretched back over the window
+        InstrumentedRenderTarget world(m_worldTexture, target.getStats(), target.getSize(), scale);
+        renderWorld(world);
+        m_worldTexture.display();
+
+        target.setLayer("upscale");
+        target.setView(target.getDefaultView());
+        sf::Vector2u size = target.getSize();
+        sf::IntRect region(0, 0, static_cast<int>(size.x * scale + 0.5f), static_cast<int>(size.y * scale + 0.5f));
+        m_worldSprite.setTexture(m_worldTexture.getTexture());
+        m_worldSprite.setTextureRect(region);
+        m_worldSprite.setScale(static_cast<float>(size.x) / region.width, static_cast<float>(size.y) / region.height);
+        target.draw(m_worldSprite);
+    }
+
+    // HUD, always at native resolution so the text stays sharp
+    target.setLayer("hud");
+    target.setView(target.getDefaultView());
+    target.draw(m_hud, m_hud.getVertexCount(), m_hud.getTexture());
+}
+
+void GameScene::renderWorld(InstrumentedRenderTarget &target)
+{
+    target.clear(sf::Color(10, 10, 20));
+
+    // Background
+    target.setLayer("background");
+    target.setView(target.getDefaultView());
+    m_background.update(m_camera.getTravelled(), sf::Vector2f(target.getSize()));
+    m_background.draw(target);
+
+    // Field Visual, fills the screen whatever the camera does
+    target.setLayer("fields");
+    target.setView(target.getDefaultView());
     // if (!m_eFieldPositiveText.getString().isEmpty()) window.draw(m_eFieldPositiveText);
     // if (!m_eFieldNegativeText.getString().isEmpty()) window.draw(m_eFieldNegativeText);
-
-    for (const auto &symbol : m_bFieldSymbols)
+    if (!m_fieldVertices.empty())
     {
-        window.draw(symbol);
+        sf::RenderStates fieldStates;
+        fieldStates.texture = &m_hudFont.getTexture(FIELD_GLYPH_SIZE);
+        target.draw(m_fieldVertices.data(), m_fieldVertices.size(), sf::Quads, fieldStates);
     }
 
+    // world, anything outside the camera is skipped before it reaches SFML
+    // everything here comes from m_atlas, so it goes out as one batch in the same order it used to be drawn
+    target.setLayer("world");
+    target.setView(m_camera.getView());
+    sf::FloatRect view = m_camera.getRect();
+    m_worldBatch.clear();
+
     // scrolls
     for (const auto &scroll : m_scrollsInScene)
     {
-        if (scroll.isActive)
+        if (scroll.isActive && view.intersects(scroll.getBounds()))
         {
-            window.draw(scroll.sprite);
+            m_worldBatch.add(scroll.sprite);
         }
     }
 
     // player
-    m_player->render(window);
+    m_worldBatch.add(m_player->getSprite());
 
     // laser
     for (const auto &laser : m_lasers)
     {
-        if (laser.isActive)
+        if (laser.isActive && view.intersects(laser.getBounds()))
         {
-            window.draw(laser.sprite);
+            m_worldBatch.add(laser.sprite);
         }
     }
     // window.draw(m_bottomLaser);
+    m_worldBatch.draw(target, m_atlas.getTexture());
 
-    // HUD
-    window.draw(m_distanceText);
-    window.draw(m_chargeText);
-    window.draw(m_dashChargesText);
+    // additive, so a second draw even though it samples the same atlas
+    target.setLayer("particles");
+    m_particles.draw(target, m_atlas.getTexture());
 }
-
-void GameScene::onVolumeChanged()
-{
-    if (m_gameMusic.getStatus() == sf::Music::Playing || m_gameMusic.getStatus() == sf::Music::Paused)
-    {
-        m_gameMusic.setVolume(m_game.getMasterVolume() * 0.7f);
-    }
-    m_laserSound.setVolume(m_game.getMasterVolume() * 0.5f);
-}
\ No newline at end of file
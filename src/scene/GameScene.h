@@ -7,7 +7,20 @@
 #include "../entities/Player.h"
 #include "../physics/PhysicsEngine.h"
 #include "../render/ResourceManager.h"
+#include "../render/Camera.h"
+#include "../render/TextureAtlas.h"
+#include "../render/SpriteBatch.h"
+#include "../render/ParticleSystem.h"
+#include "../render/ParallaxBackground.h"
+#include "../ui/HudReadout.h"
+#include "../level/ChunkGenerator.h"
+#include "../level/LevelFile.h"
+#include "../level/PatternScript.h"
+#include "../core/RewindBuffer.h"
+#include "GameSnapshot.h"
+#include "../core/TimingWheel.h"
 #include <SFML/Audio.hpp>
+#include <array>
 #include <vector>
 #include <random>
 
@@ -17,12 +30,14 @@ struct Laser
     sf::Sprite sprite;
     sf::Vector2f velocity;
     bool isActive = true;
+    std::uint32_t slot = 0; // stable id for scheduled events, the vector index changes on removal
 
-    Laser(sf::Texture &texture, sf::Vector2f pos, sf::Vector2f vel, float initialRotation = 0.f)
+    Laser(const sf::Texture &atlas, const sf::IntRect &region, sf::Vector2f pos, sf::Vector2f vel, float initialRotation = 0.f)
         : velocity(vel)
     {
-        sprite.setTexture(texture);
-        sprite.setOrigin(texture.getSize().x / 2.f, texture.getSize().y / 2.f);
+        sprite.setTexture(atlas);
+        sprite.setTextureRect(region);
+        sprite.setOrigin(region.width / 2.f, region.height / 2.f);
         sprite.setPosition(pos);
         // shape.setSize(size);
         // shape.setFillColor(color);
@@ -45,13 +60,12 @@ struct ScrollItem
     sf::Sprite sprite;
     int id;
     bool isActive = true;
-    sf::Texture *texturePtr; // avoid copying texture
 
-    ScrollItem(int scrollId, sf::Texture &tex, sf::Vector2f pos) : id(scrollId)
+    ScrollItem(int scrollId, const sf::Texture &atlas, const sf::IntRect &region, sf::Vector2f pos) : id(scrollId)
     {
-        texturePtr = &tex;
-        sprite.setTexture(*texturePtr);
-        sprite.setOrigin(tex.getSize().x / 2.f, tex.getSize().y / 2.f);
+        sprite.setTexture(atlas);
+        sprite.setTextureRect(region);
+        sprite.setOrigin(region.width / 2.f, region.height / 2.f);
         sprite.setPosition(pos);
         // sprite.setScale(0.2f, 0.2f);
 
@@ -62,76 +76,206 @@ struct ScrollItem
     sf::FloatRect getBounds() const { return sprite.getGlobalBounds(); }
 };
 
+// everything GameScene does at a known future time, fired by m_events
+enum class GameEventType : std::uint8_t
+{
+    SpawnLaser,     // a = chunk index, b = laser in that chunk
+    SpawnScroll,    // a = chunk index, b = scroll in that chunk
+    NextChunk,      // the camera reached the end of the current chunk
+    DespawnLaser,   // a = laser slot, b = slot generation, predicted from the velocity at spawn
+    StartPattern,   // a = chunk index, b = pattern trigger in that chunk
+    ResumePattern,  // a = pattern slot, b = slot generation, its wait is over
+    ReloadPatterns, // polls the pattern file for edits
+};
+
+struct GameEvent
+{
+    GameEventType type;
+    std::uint32_t a = 0;
+    std::uint32_t b = 0;
+};
+
+// a scripted wave in flight, slots are reused so nothing allocates while patterns run
+struct PatternInstance
+{
+    PatternState state;
+    std::uint64_t startTick = 0;
+    std::uint32_t generation = 0;
+    bool isActive = false;
+};
+
 class GameScene : public Scene
 {
+    friend class Benchmark;             // stress scenarios poke lasers and fields directly
+    friend struct GameSceneBenchAccess; // bench/EngineBench.cpp
+
 public:
     explicit GameScene(Game &game);
     ~GameScene() override;
 
     void loadAssets() override;
+    void onEnter() override;
+    void onExit() override;
+    void onQualityChanged() override;
     void handleInput(sf::Event &event, sf::RenderWindow &window) override;
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow &window) override;
-    void onVolumeChanged() override;
-    sf::Music *getMusic() override { return &m_gameMusic; }
+    void render(InstrumentedRenderTarget &target) override;
+    std::size_t getDebugCounters(DebugCounter *out, std::size_t capacity) const override;
 
 private:
     void setupInitialState();
+    void simulate(sf::Time deltaTime);
+    void startLevel(std::uint32_t seed);
+    void seekChunk(std::uint32_t index);
+    void updateEvents(sf::Time deltaTime);
+    void fireEvent(const GameEvent &event);
+    void nextChunk();
+    void enterChunk();
     void updateHUD();
-    void spawnLaser();
-    void spawnScroll();
+    void spawnLaser(const LaserSpawn &spawn);
+    void playLaserSound(float screenX);
+    void startPattern(std::uint32_t pattern, std::uint32_t seed);
+    void resumePattern(std::uint32_t slot, std::uint32_t generation);
+    void stopPatterns();
+    void firePatternShot(const PatternShot &shot);
+    void addLaser(sf::Vector2f screenPos, sf::Vector2f screenVelocity, float rotation);
+    void removeLaser(std::uint32_t slot, std::uint32_t generation);
+    void clearLasers();
+    void rebaseWorld();
+    void spawnScroll(float yFraction);
     void updateLasers(sf::Time deltaTime);
-    void updateScrolls(sf::Time deltaTime);
-    void updateBackground(sf::Time deltaTime);
+    void updateParticles(sf::Time deltaTime);
+    void emitDash(sf::Vector2f direction);
+    void emitChargeSparks();
+    bool checkLaserCollisions() const;
+    void updateScrolls();
     void updateFieldVisuals();
+    void addFieldQuad(sf::Vector2f topLeft, sf::Vector2f bottomRight, sf::Color color, sf::FloatRect textureRect = {1.f, 1.f, 0.f, 0.f});
+    void setBackgroundResolution(unsigned int divisor);
+    float getRenderScale() const; // Game's setting times the quality level's
+    void renderWorld(InstrumentedRenderTarget &target); // everything below the HUD
     void randomizeFields();
 
-    sf::Sprite m_backgroundSprite1;
-    sf::Sprite m_backgroundSprite2; // better scroll
+    bool captureSnapshot(GameSnapshot &snapshot) const;
+    void restoreSnapshot(const GameSnapshot &snapshot);
+    bool recordSnapshot();
+    void runAhead(sf::Time deltaTime);
+    void leaveRunAhead();
+    void startRewind();
+    void updateRewind(sf::Time deltaTime);
+    void stopRewind();
+
+    Camera m_camera; // world space, scrolls at m_bgScrollSpeed
+
+    ParallaxBackground m_background;
     float m_bgScrollSpeed = 100.f;
     sf::Texture m_gameBgTexture;
+    std::array<sf::Texture, 2> m_reducedBgTextures; // 1/2 and 1/4 resolution, for lower quality levels
+    float m_bgScale = 1.f;                           // of the full resolution texture
+    unsigned int m_bgDivisor = 1;
 
     // Player m_player;
     std::unique_ptr<Player> m_player;
     PhysicsEngine m_physicsEngine;
     FieldProperties m_currentFields;
 
-    sf::Music m_gameMusic;
-    sf::Sound m_laserSound;
+    const sf::SoundBuffer *m_laserSoundBuffer = nullptr; // played through Game's AudioMixer
 
     // HUD
     sf::Font m_hudFont;
-    sf::Text m_distanceText;
-    sf::Text m_chargeText;
-    sf::Text m_dashChargesText;
+    HudReadout m_hud;
+    std::size_t m_distanceField = 0;
+    std::size_t m_chargeField = 0;
+    std::size_t m_dashChargesField = 0;
     float m_distanceTraveled = 0.f;
 
     // Game
     // sf::RectangleShape m_bottomLaser;
     std::vector<Laser> m_lasers;
+    std::vector<std::uint32_t> m_laserIndexBySlot;    // slot -> index into m_lasers
+    std::vector<std::uint32_t> m_laserSlotGeneration; // bumped on removal, stale despawns don't match
+    std::vector<std::uint32_t> m_freeLaserSlots;
     std::vector<ScrollItem> m_scrollsInScene;
 
-    // laserspawn
-    sf::Time m_laserSpawnTimer;
-    sf::Time m_timeBetweenLaserSpawns = sf::seconds(2.f); // random this later
-    sf::Time m_scrollSpawnTimer;
-    sf::Time m_timeBetweenScrollSpawns = sf::seconds(10.f);
+    // course, streamed in LevelChunk::WIDTH slices from the worker thread or a mapped level file
+    ChunkGenerator m_chunkGenerator;
+    std::uint32_t m_courseSeed = 0;
+    LevelFile m_levelFile;         // open = play the authored course instead of generating one
+    LevelChunk m_generatedChunk;   // storage m_chunk points into when generating
+    LevelChunkView m_chunk;        // the one under the player
+    bool m_hasChunk = false;       // false = worker fell behind or the course ended, this slice is empty
+    std::uint32_t m_chunkIndex = 0;
+    float m_chunkX = 0.f;          // px scrolled into m_chunk
+    std::uint64_t m_chunkStartTick = 0;
     int m_maxScrollsOnScreen = 1;
 
-    std::vector<sf::Text> m_bFieldSymbols;
-    std::vector<sf::VertexArray> m_eFieldLines;
+    // timed events on simulation time, 1 tick = 1 ms. nothing polls its own timer per frame
+    static constexpr std::uint64_t EVENT_TICK_US = 1000;
+    TimingWheel<GameEvent> m_events;
+    std::uint64_t m_simTimeUs = 0;
+
+    // scripted waves, the file is recompiled when it is saved and running waves restart on the new code
+    static constexpr std::size_t MAX_PATTERN_INSTANCES = 1024;
+    static constexpr std::uint64_t PATTERN_RELOAD_TICKS = 500;
+    PatternLibrary m_patterns;
+    std::vector<PatternInstance> m_patternInstances;
+    std::vector<std::uint32_t> m_freePatternSlots;
+
+    // rewind (hold R): one snapshot per update covering REWIND_WINDOW_US, in a fixed budget
+    static constexpr std::uint64_t REWIND_WINDOW_US = 10000000;
+    static constexpr std::size_t REWIND_BUDGET_BYTES = 8 * 1024 * 1024;
+    static constexpr std::size_t REWIND_MAX_RECORDS = 4096; // 10 s at up to ~400 updates/s
+    static constexpr std::size_t REWIND_KEYFRAME_INTERVAL = 30;
+    RewindBuffer<GameSnapshot> m_rewind;
+    GameSnapshot m_snapshot{}; // scratch for capture and restore, too big for the stack
+    bool m_rewinding = false;
+    bool m_frozenAtDeath = false; // Game::getRewindDeaths
+    std::uint64_t m_rewindCursorUs = 0;
+    std::size_t m_rewindIndex = RewindBuffer<GameSnapshot>::NONE;
+
+    // run-ahead (Game::getRunAheadFrames): after the real update the scene steps that many frames further
+    // on the same input and presents the result, the next input or update first restores m_snapshot.
+    // speculative frames play no sounds, collect nothing and can't end the run
+    bool m_speculative = false;
+    LevelChunk m_runAheadChunk;     // m_generatedChunk at the real state, a speculative frame may replace it
+    LevelChunkView m_runAheadView;
+
+    // B symbols and E arrows as quads in one array, drawn in one call with m_hudFont's FIELD_GLYPH_SIZE page.
+    // the arrows sample the page's white texel at (1, 1), the one sf::Text underlines use
+    std::vector<sf::Vertex> m_fieldVertices; // reserved for the densest grid in loadAssets
+    std::size_t m_fieldSymbolCount = 0;
+    sf::Glyph m_bOutGlyph; // '.'
+    sf::Glyph m_bInGlyph;  // 'X'
+    static constexpr unsigned int FIELD_GLYPH_SIZE = 150;
+    static constexpr int E_FIELD_LINES = 5;
+    static constexpr float E_FIELD_LINE_WIDTH = 2.f;
+    FieldProperties m_visualizedFields; // fields the visuals were last built for
+    bool m_fieldVisualsValid = false;
 
     std::mt19937 m_rng;
 
     bool m_isGameOver = false;
+    bool m_invulnerable = false; // benchmark mode, ignore deaths
 
     // B field
     static constexpr float B_FIELD_DENSITY_SCALE_FACTOR = 10.0f;
+    float m_bFieldDensityScale = 1.f; // quality level, also thins the per row/col cap
     static constexpr int MAX_B_FIELD_SYMBOLS_PER_ROW_COL = 15;
 
-    sf::Texture m_playerTexture;
-    sf::Texture m_scrollItemTexture;
-    sf::Texture m_laserTexture;
+    // player, scrolls and lasers share one texture so the world layer is a single draw
+    TextureAtlas m_atlas;
+    sf::IntRect m_playerRegion;
+    sf::IntRect m_scrollRegion;
+    sf::IntRect m_laserRegion;
+    SpriteBatch m_worldBatch;
+
+    // visual only: not in snapshots, run-ahead frames don't touch it
+    ParticleSystem m_particles;
+
+    // the world below the HUD at getRenderScale() < 1, created on first use
+    sf::RenderTexture m_worldTexture;
+    sf::Sprite m_worldSprite;
+    bool m_worldTextureFailed = false;
 };
 
 #endif // GAMESCENE_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+// src/scene/GameSnapshot.h
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include "../level/PatternScript.h"
+
+// everything GameScene needs to continue a run from one tick, as flat fixed-size data
+// so RewindBuffer can diff it word by word. unused tail entries are left as they were, which keeps deltas small.
+// chunk contents aren't stored: chunk n is regenerated from (seed, n) or re-read from the level file
+struct GameSnapshot
+{
+    static constexpr std::size_t MAX_LASERS = 512;
+    static constexpr std::size_t MAX_SCROLLS = 4;
+    static constexpr std::size_t MAX_EVENTS = MAX_LASERS + 256;
+    static constexpr std::size_t MAX_PATTERNS = 32;
+
+    struct LaserRecord
+    {
+        float x, y;
+        float vx, vy;
+        float rotation;
+        std::uint32_t slot;
+        std::uint32_t generation;
+        std::uint32_t reserved;
+    };
+
+    struct ScrollRecord
+    {
+        float x, y;
+        std::int32_t id;
+        std::uint32_t reserved;
+    };
+
+    struct EventRecord
+    {
+        std::uint64_t due;
+        std::uint32_t type;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t reserved;
+    };
+
+    struct PatternRecord
+    {
+        std::uint64_t startTick;
+        std::uint32_t slot;
+        std::uint32_t generation;
+        PatternState state;
+    };
+
+    // time
+    std::uint64_t simTimeUs;
+    std::uint64_t eventTick;
+    std::uint64_t chunkStartTick;
+
+    // camera, in the world frame of that tick. the background follows from it
+    double cameraRebased;
+    float cameraLeft;
+
+    // player
+    float playerX, playerY;
+    float playerVX, playerVY;
+    float playerCharge;
+    std::int32_t dashCharges;
+
+    // fields and course
+    float electricX, electricY;
+    float magneticZ;
+    std::uint32_t courseSeed;
+    std::uint32_t chunkIndex;
+    std::uint32_t hasChunk;
+
+    std::uint32_t laserCount;
+    std::uint32_t scrollCount;
+    std::uint32_t eventCount;
+    std::uint32_t patternCount;
+
+    std::uint32_t rng[(sizeof(std::mt19937) + 3) / 4]; // GameScene::m_rng, copied raw
+
+    LaserRecord lasers[MAX_LASERS];
+    ScrollRecord scrolls[MAX_SCROLLS];
+    EventRecord events[MAX_EVENTS];
+    PatternRecord patterns[MAX_PATTERNS];
+};
+
+static_assert(std::is_trivially_copyable<std::mt19937>::value, "GameSnapshot copies the engine's bytes");
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot is diffed as raw words");
+
+#endif // GAMESNAPSHOT_H
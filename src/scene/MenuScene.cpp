@@ -23,10 +23,6 @@ MenuScene::MenuScene(Game &game)
 
 MenuScene::~MenuScene()
 {
-    if (m_menuMusic.getStatus() == sf::Music::Playing)
-    {
-        m_menuMusic.stop();
-    }
     std::cout << "MenuScene destroyed." << std::endl;
 }
 
@@ -61,26 +57,31 @@ void MenuScene::loadAssets()
         float titleX = (m_game.getWindow().getSize().x + SIDEBAR_WIDTH) / 2.0f;
         m_gameTitleText.setPosition(titleX, m_game.getWindow().getSize().y * 0.2f);
 
-        // music
-        if (!m_menuMusic.openFromFile("../../assets/audio/menu_theme.ogg"))
-        {
-            throw std::runtime_error("Failed to load menu_theme.ogg");
-        }
-        m_menuMusic.setLoop(true);
-        m_menuMusic.setVolume(m_game.getMasterVolume());
-        m_menuMusic.play();
-
         // scroll
         m_scrollIconTexture = ResourceManager::getInstance().loadTexture("scroll_item_icon", "../../assets/images/scroll_item.png");
+
+        // cached layer, falls back to drawing straight to the window if this fails
+        m_staticLayerReady = m_staticLayer.create(windowSize.x, windowSize.y);
+        if (m_staticLayerReady)
+        {
+            m_staticLayerSprite.setTexture(m_staticLayer.getTexture(), true);
+        }
     }
     catch (const std::runtime_error &e)
     {
         std::cerr << "Error loading assets in MenuScene: " << e.what() << std::endl;
     }
-    setupUI(); // Setup UI elements after assets are potentially loaded
     std::cout << "MenuScene assets loaded." << std::endl;
 }
 
+void MenuScene::onEnter()
+{
+    // collected scrolls may have changed while suspended
+    m_isViewingScroll = false;
+    setupUI();
+    m_game.getMusicService().crossfadeTo(MusicTrack::Menu, sf::seconds(1.f)); // resumes where it faded out
+}
+
 void MenuScene::setupUI()
 {
     sf::Vector2u windowSize = m_game.getWindow().getSize();
@@ -188,18 +189,37 @@ void MenuScene::setupUI()
                                       m_scrollDisplayBackground.getPosition().y + m_scrollDisplayBackground.getSize().y - BUTTON_HEIGHT - PADDING},
                                      {100.f, BUTTON_HEIGHT});
     m_closeScrollViewButton.setOnClickAction([this]()
-                                             { m_isViewingScroll = false; });
+                                             { setViewingScroll(false); });
+    invalidate();
 }
 
 void MenuScene::displayScrollContent(int scrollId)
 {
     m_scrollDisplayContentText.setString(m_game.getScrollContent(scrollId));
 
-    m_isViewingScroll = true;
+    setViewingScroll(true);
+}
+
+void MenuScene::setViewingScroll(bool viewing)
+{
+    m_isViewingScroll = viewing;
+    invalidate();
+}
+
+void MenuScene::invalidate()
+{
+    m_layerDirty = true;
+    m_needsPresent = true;
 }
 
 void MenuScene::handleInput(sf::Event &event, sf::RenderWindow &window)
 {
+    if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus)
+    {
+        // the window contents may have been lost, present the cached layer again
+        m_needsPresent = true;
+    }
+
     if (m_isViewingScroll)
     {
         if (event.type == sf::Event::MouseButtonPressed)
@@ -214,7 +234,7 @@ void MenuScene::handleInput(sf::Event &event, sf::RenderWindow &window)
         }
         if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
         {
-            m_isViewingScroll = false;
+            setViewingScroll(false);
         }
         return;
     }
@@ -258,43 +278,66 @@ void MenuScene::update(sf::Time deltaTime)
 {
 }
 
-void MenuScene::render(sf::RenderWindow &window)
+void MenuScene::render(InstrumentedRenderTarget &target)
+{
+    target.setLayer("menu");
+    if (!m_staticLayerReady)
+    {
+        drawStaticLayer(target);
+        m_needsPresent = false;
+        return;
+    }
+    if (m_layerDirty)
+    {
+        rebuildStaticLayer(target.getStats());
+    }
+    target.draw(m_staticLayerSprite);
+    m_needsPresent = false;
+}
+
+void MenuScene::rebuildStaticLayer(RenderStats &stats)
+{
+    // offscreen, but the draws still cost a frame
+    InstrumentedRenderTarget layer(m_staticLayer, stats);
+    layer.setLayer("menuCache");
+    drawStaticLayer(layer);
+    m_staticLayer.display();
+    m_layerDirty = false;
+}
+
+void MenuScene::drawStaticLayer(InstrumentedRenderTarget &target)
 {
-    window.clear(sf::Color(30, 30, 30)); // dark bg
-    window.draw(m_backgroundSprite);
-    window.draw(m_gameTitleText);
+    target.clear(sf::Color(30, 30, 30)); // dark bg
+    target.draw(m_backgroundSprite);
+    target.draw(m_gameTitleText);
 
-    m_startButton.draw(window);
-    m_exitButton.draw(window);
+    m_startButton.draw(target);
+    m_exitButton.draw(target);
 
     // sidebar
-    window.draw(m_sidebarBackground);
-    window.draw(m_settingsTitle);
-    m_volumeUpButton.draw(window);
-    m_volumeDownButton.draw(window);
-    window.draw(m_volumeValueText);
+    target.draw(m_sidebarBackground);
+    target.draw(m_settingsTitle);
+    m_volumeUpButton.draw(target);
+    m_volumeDownButton.draw(target);
+    target.draw(m_volumeValueText);
 
-    window.draw(m_collectionTitle);
+    target.draw(m_collectionTitle);
     for (auto &scrollBtn : m_scrollButtons)
     {
-        scrollBtn.draw(window);
+        scrollBtn.draw(target);
     }
 
     // scroll view
     if (m_isViewingScroll)
     {
-        window.draw(m_scrollDisplayBackground);
-        window.draw(m_scrollDisplayContentText);
-        m_closeScrollViewButton.draw(window);
+        target.draw(m_scrollDisplayBackground);
+        target.draw(m_scrollDisplayContentText);
+        m_closeScrollViewButton.draw(target);
     }
 }
 
 void MenuScene::onVolumeChanged()
 {
-    if (m_menuMusic.getStatus() == sf::Music::Playing || m_menuMusic.getStatus() == sf::Music::Paused)
-    {
-        m_menuMusic.setVolume(m_game.getMasterVolume());
-    }
     m_volumeValueText.setString(std::to_string(static_cast<int>(m_game.getMasterVolume())));
 
     sf::FloatRect textRect = m_volumeValueText.getLocalBounds();
@@ -302,4 +345,5 @@ void MenuScene::onVolumeChanged()
                                 textRect.top + textRect.height / 2.0f);
     m_volumeValueText.setPosition(m_volumeDownButton.shape.getPosition().x + m_volumeDownButton.shape.getSize().x + PADDING + 30.f,
                                   m_volumeDownButton.shape.getPosition().y + m_volumeDownButton.shape.getSize().y / 2.f);
+    invalidate();
 }
\ No newline at end of file
@@ -16,15 +16,22 @@ public:
     ~MenuScene() override;
 
     void loadAssets() override;
+    void onEnter() override;
     void handleInput(sf::Event &event, sf::RenderWindow &window) override;
     void update(sf::Time deltaTime) override;
-    void render(sf::RenderWindow &window) override;
+    void render(InstrumentedRenderTarget &target) override;
     void onVolumeChanged() override;
-    sf::Music *getMusic() override { return &m_menuMusic; }
+    bool needsPresent() const override { return m_needsPresent; }
 
 private:
     void setupUI();
     void displayScrollContent(int scrollId);
+    void setViewingScroll(bool viewing);
+
+    // everything in the menu is static, so it is drawn once into m_staticLayer and composited with one draw
+    void invalidate();
+    void rebuildStaticLayer(RenderStats &stats);
+    void drawStaticLayer(InstrumentedRenderTarget &target);
 
     sf::Sprite m_backgroundSprite;
     sf::Text m_gameTitleText;
@@ -44,12 +51,17 @@ private:
     std::vector<Button> m_scrollButtons; // view collected scroll
     sf::Texture m_scrollIconTexture;
 
-    sf::Music m_menuMusic;
 
     bool m_isViewingScroll = false;
     sf::Text m_scrollDisplayContentText;
     sf::RectangleShape m_scrollDisplayBackground;
     Button m_closeScrollViewButton;
+
+    sf::RenderTexture m_staticLayer;
+    sf::Sprite m_staticLayerSprite;
+    bool m_staticLayerReady = false; // render texture created
+    bool m_layerDirty = true;
+    bool m_needsPresent = true;
 };
 
 #endif // MENUSCENE_H
\ No newline at end of file
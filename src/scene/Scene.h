@@ -4,28 +4,44 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <cstddef>
+#include "../render/InstrumentedRenderTarget.h"
 
 class Game;
+struct DebugCounter;
 
 class Scene
 {
 public:
     virtual ~Scene() = default;
 
-    // when scene set as current
+    // once, when Game first creates the scene
     virtual void loadAssets() = 0;
 
+    // scenes are pooled by Game, these run on every switch to / away from the scene
+    virtual void onEnter() {}
+    virtual void onExit() {}
+
     // SFML events
     virtual void handleInput(sf::Event &event, sf::RenderWindow &window) = 0;
 
     // update scene
     virtual void update(sf::Time deltaTime) = 0;
 
-    virtual void render(sf::RenderWindow &window) = 0;
+    // target counts draws per layer for the F3 overlay, see InstrumentedRenderTarget::setLayer
+    virtual void render(InstrumentedRenderTarget &target) = 0;
+
+    // master volume changed, music and effects already follow it through Game
+    virtual void onVolumeChanged() {}
+
+    // Game's quality level changed, see QualityGovernor. also called when the scene becomes current
+    virtual void onQualityChanged() {}
 
-    virtual void onVolumeChanged() = 0;
+    // false when the last presented frame is still correct, Game then skips the frame and waits for events
+    virtual bool needsPresent() const { return true; }
 
-    virtual sf::Music *getMusic() { return nullptr; }
+    // what is alive right now, for hitch reports. fills up to capacity entries, returns how many
+    virtual std::size_t getDebugCounters(DebugCounter * /*out*/, std::size_t /*capacity*/) const { return 0; }
 
 protected:
     Game &m_game;
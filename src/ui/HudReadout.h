@@ -0,0 +1,193 @@
+#ifndef HUDREADOUT_H
+#define HUDREADOUT_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// "Label: 123" HUD lines drawn from prebaked font glyphs in one vertex array
+// a line is only re-laid out when its displayed value changes, setValue never allocates
+class HudReadout : public sf::Drawable
+{
+public:
+    void setFont(const sf::Font &font, unsigned int characterSize)
+    {
+        m_font = &font;
+        m_characterSize = characterSize;
+        m_fields.clear();
+        m_vertices.clear();
+        m_vertices.setPrimitiveType(sf::Quads);
+        m_glyphs = {};
+        // digits and punctuation up front, labels get baked as they are added
+        bakeGlyphs("0123456789.- ");
+    }
+
+    // returns the field index for setValue
+    std::size_t addField(const char *label, sf::Vector2f position, sf::Color color, int decimals = 0)
+    {
+        Field field;
+        std::strncpy(field.label, label, sizeof(field.label) - 1);
+        field.labelLength = std::strlen(field.label);
+        field.position = position;
+        field.color = color;
+        field.decimals = std::max(0, std::min(decimals, 3));
+        field.firstVertex = m_vertices.getVertexCount();
+        bakeGlyphs(field.label);
+
+        // fixed slot per field so one changing value never shifts the others
+        m_vertices.resize(m_vertices.getVertexCount() + MAX_CHARS * 4);
+        m_fields.push_back(field);
+        return m_fields.size() - 1;
+    }
+
+    // what draw() submits, for render stats
+    std::size_t getVertexCount() const { return m_vertices.getVertexCount(); }
+    const sf::Texture *getTexture() const { return m_font ? &m_font->getTexture(m_characterSize) : nullptr; }
+
+    void setValue(std::size_t index, float value)
+    {
+        Field &field = m_fields[index];
+        long long scaled = std::llround(value * POWERS_OF_TEN[field.decimals]);
+        if (field.valid && scaled == field.displayed)
+        {
+            return;
+        }
+        field.displayed = scaled;
+        field.valid = true;
+        layout(field);
+    }
+
+private:
+    static constexpr std::size_t MAX_CHARS = 32;
+    static constexpr float POWERS_OF_TEN[4] = {1.f, 10.f, 100.f, 1000.f};
+
+    struct GlyphQuad
+    {
+        bool baked = false;
+        float advance = 0.f;
+        sf::FloatRect bounds;
+        sf::IntRect textureRect;
+    };
+
+    struct Field
+    {
+        char label[MAX_CHARS / 2] = {};
+        std::size_t labelLength = 0;
+        sf::Vector2f position;
+        sf::Color color;
+        int decimals = 0;
+        std::size_t firstVertex = 0;
+        long long displayed = 0;
+        bool valid = false;
+    };
+
+    void bakeGlyphs(const char *chars)
+    {
+        for (const char *c = chars; *c; ++c)
+        {
+            unsigned char code = static_cast<unsigned char>(*c);
+            if (code >= m_glyphs.size() || m_glyphs[code].baked)
+            {
+                continue;
+            }
+            // getGlyph puts the glyph on the font page for this size, texture rects stay valid when the page grows
+            const sf::Glyph &glyph = m_font->getGlyph(code, m_characterSize, false);
+            m_glyphs[code].baked = true;
+            m_glyphs[code].advance = glyph.advance;
+            m_glyphs[code].bounds = glyph.bounds;
+            m_glyphs[code].textureRect = glyph.textureRect;
+        }
+    }
+
+    // value -> chars without snprintf/std::string, returns length
+    static std::size_t formatFixed(long long scaled, int decimals, char *out)
+    {
+        char digits[24];
+        std::size_t count = 0;
+        bool negative = scaled < 0;
+        unsigned long long magnitude = negative ? 0ULL - static_cast<unsigned long long>(scaled) : static_cast<unsigned long long>(scaled);
+        do
+        {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0 || count < static_cast<std::size_t>(decimals) + 1);
+
+        std::size_t length = 0;
+        if (negative)
+        {
+            out[length++] = '-';
+        }
+        while (count > 0)
+        {
+            if (count == static_cast<std::size_t>(decimals) && decimals > 0)
+            {
+                out[length++] = '.';
+            }
+            out[length++] = digits[--count];
+        }
+        return length;
+    }
+
+    void layout(const Field &field)
+    {
+        char text[MAX_CHARS * 2];
+        std::size_t length = field.labelLength;
+        std::memcpy(text, field.label, length);
+        length += formatFixed(field.displayed, field.decimals, text + length);
+        length = std::min(length, MAX_CHARS);
+
+        // same baseline as sf::Text at this position
+        float x = field.position.x;
+        float baseline = field.position.y + static_cast<float>(m_characterSize);
+        for (std::size_t i = 0; i < MAX_CHARS; ++i)
+        {
+            sf::Vertex *quad = &m_vertices[field.firstVertex + i * 4];
+            if (i >= length)
+            {
+                // collapse unused quads
+                for (int v = 0; v < 4; ++v)
+                {
+                    quad[v] = sf::Vertex(field.position, sf::Color::Transparent);
+                }
+                continue;
+            }
+            const GlyphQuad &glyph = m_glyphs[static_cast<unsigned char>(text[i])];
+            float left = x + glyph.bounds.left;
+            float top = baseline + glyph.bounds.top;
+            float right = left + glyph.bounds.width;
+            float bottom = top + glyph.bounds.height;
+            float u0 = static_cast<float>(glyph.textureRect.left);
+            float v0 = static_cast<float>(glyph.textureRect.top);
+            float u1 = u0 + glyph.textureRect.width;
+            float v1 = v0 + glyph.textureRect.height;
+
+            quad[0] = sf::Vertex({left, top}, field.color, {u0, v0});
+            quad[1] = sf::Vertex({right, top}, field.color, {u1, v0});
+            quad[2] = sf::Vertex({right, bottom}, field.color, {u1, v1});
+            quad[3] = sf::Vertex({left, bottom}, field.color, {u0, v1});
+            x += glyph.advance;
+        }
+    }
+
+    void draw(sf::RenderTarget &target, sf::RenderStates states) const override
+    {
+        if (!m_font || m_vertices.getVertexCount() == 0)
+        {
+            return;
+        }
+        // every field shares the font page for this size, so this is a single draw call
+        states.texture = &m_font->getTexture(m_characterSize);
+        target.draw(m_vertices, states);
+    }
+
+    const sf::Font *m_font = nullptr;
+    unsigned int m_characterSize = 24;
+    std::array<GlyphQuad, 128> m_glyphs{};
+    std::vector<Field> m_fields;
+    sf::VertexArray m_vertices;
+};
+
+#endif // HUDREADOUT_H
@@ -0,0 +1,163 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <string>
+#include "../core/Profiler.h"
+#include "../core/AllocationTracker.h"
+#include "../core/FrameArena.h"
+#include "../core/LatencyTracker.h"
+#include "../core/QualityGovernor.h"
+#include "../render/InstrumentedRenderTarget.h"
+
+// F3 debug overlay: frame time, quality level, input latency, draw counts per layer, per-scope time and allocations
+class ProfilerOverlay
+{
+public:
+    void setFont(const sf::Font &font)
+    {
+        m_text.setFont(font);
+        m_text.setCharacterSize(14);
+        m_text.setFillColor(sf::Color(180, 255, 180));
+        m_text.setPosition(PADDING, PADDING);
+        m_background.setPosition(0.f, 0.f);
+        m_background.setFillColor(sf::Color(0, 0, 0, 170));
+        m_buffer.reserve(2048);
+    }
+
+    void setFrameArena(const FrameArena *arena) { m_frameArena = arena; }
+    void setLatencyTracker(const LatencyTracker *latency) { m_latency = latency; }
+    void setRenderStats(const RenderStats *stats) { m_renderStats = stats; }
+    void setQualityGovernor(const QualityGovernor *quality) { m_quality = quality; }
+
+    void toggle()
+    {
+        m_visible = !m_visible;
+        m_sinceRefresh = REFRESH_INTERVAL; // refresh on the next update
+    }
+    bool isVisible() const { return m_visible; }
+
+    // text is rebuilt a few times per second, not every frame
+    void update(sf::Time deltaTime)
+    {
+        if (!m_visible)
+        {
+            return;
+        }
+        m_sinceRefresh += deltaTime;
+        if (m_sinceRefresh < REFRESH_INTERVAL)
+        {
+            return;
+        }
+        m_sinceRefresh = sf::Time::Zero;
+
+        const Profiler &profiler = Profiler::getInstance();
+        bool tracking = AllocationTracker::isEnabled();
+        char line[128];
+
+        m_buffer.clear();
+        std::snprintf(line, sizeof(line), "frame %.2f ms (%.0f fps)\n", profiler.getFrameTimeMs(),
+                      profiler.getFrameTimeMs() > 0.0 ? 1000.0 / profiler.getFrameTimeMs() : 0.0);
+        m_buffer += line;
+        if (tracking)
+        {
+            std::snprintf(line, sizeof(line), "allocs %zu / frame, %zu bytes\n", profiler.getFrameAllocations(), profiler.getFrameBytes());
+        }
+        else
+        {
+            std::snprintf(line, sizeof(line), "allocs: off (run with --track-allocs)\n");
+        }
+        m_buffer += line;
+        if (m_frameArena)
+        {
+            std::snprintf(line, sizeof(line), "arena %zu / %zu KB, peak %zu KB, overflows %zu\n", m_frameArena->getUsed() / 1024,
+                          m_frameArena->getCapacity() / 1024, m_frameArena->getHighWaterMark() / 1024, m_frameArena->getOverflowCount());
+            m_buffer += line;
+        }
+        if (m_quality)
+        {
+            const QualitySettings &settings = m_quality->getSettings();
+            std::snprintf(line, sizeof(line), "quality %s (%s), cpu %.2f / %.2f ms, %zu changes", settings.name,
+                          m_quality->isAutomatic() ? "auto" : "fixed", m_quality->getRollingMs(), m_quality->getBudgetMs(),
+                          m_quality->getChangeCount());
+            m_buffer += line;
+            if (m_quality->getLastStep() != 0)
+            {
+                std::snprintf(line, sizeof(line), ", last %s at %.2f ms", m_quality->getLastStep() > 0 ? "down" : "up",
+                              m_quality->getLastStepMs());
+                m_buffer += line;
+            }
+            std::snprintf(line, sizeof(line), "\n  bfield %.0f%% particles %.0f%% bg 1/%u voices %zu scale %.0f%%\n",
+                          settings.bFieldDensity * 100.f, settings.particles * 100.f, settings.backgroundDivisor, settings.audioVoices,
+                          settings.renderScale * 100.f);
+            m_buffer += line;
+        }
+        if (m_latency)
+        {
+            std::snprintf(line, sizeof(line), "input->display p50 %.1f p95 %.1f p99 %.1f ms (%zu keys)\n",
+                          m_latency->getPercentileMs(50.0), m_latency->getPercentileMs(95.0), m_latency->getPercentileMs(99.0),
+                          m_latency->getSampleCount());
+            m_buffer += line;
+        }
+        if (m_renderStats)
+        {
+            RenderLayerStats total = m_renderStats->getTotal();
+            std::snprintf(line, sizeof(line), "draws %zu, %zu verts, %zu tex, %zu blend\n", total.draws, total.vertices,
+                          total.textureSwitches, total.blendChanges);
+            m_buffer += line;
+            for (std::size_t i = 0; i < m_renderStats->getLayerCount(); ++i)
+            {
+                const RenderLayerStats &layer = m_renderStats->getLayer(i);
+                std::snprintf(line, sizeof(line), "  %-12s %5zu d %7zu v %4zu t %3zu b\n", layer.name, layer.draws, layer.vertices,
+                              layer.textureSwitches, layer.blendChanges);
+                m_buffer += line;
+            }
+        }
+
+        for (std::size_t i = 0; i < profiler.getScopeCount(); ++i)
+        {
+            const ProfileScopeStats &scope = profiler.getScope(i);
+            if (tracking)
+            {
+                std::snprintf(line, sizeof(line), "%-16s %7.3f ms x%-3d %5zu a %7zu B\n", scope.name, scope.timeMs, scope.calls,
+                              scope.allocations, scope.bytes);
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line), "%-16s %7.3f ms x%d\n", scope.name, scope.timeMs, scope.calls);
+            }
+            m_buffer += line;
+        }
+        m_text.setString(m_buffer);
+
+        sf::FloatRect bounds = m_text.getLocalBounds();
+        m_background.setSize({bounds.left + bounds.width + PADDING * 2.f, bounds.top + bounds.height + PADDING * 2.f});
+    }
+
+    void draw(sf::RenderWindow &window)
+    {
+        if (!m_visible)
+        {
+            return;
+        }
+        window.draw(m_background);
+        window.draw(m_text);
+    }
+
+private:
+    static constexpr float PADDING = 8.f;
+    const sf::Time REFRESH_INTERVAL = sf::seconds(0.25f);
+
+    bool m_visible = false;
+    const FrameArena *m_frameArena = nullptr;
+    const LatencyTracker *m_latency = nullptr;
+    const RenderStats *m_renderStats = nullptr;
+    const QualityGovernor *m_quality = nullptr;
+    sf::Time m_sinceRefresh;
+    sf::Text m_text;
+    sf::RectangleShape m_background;
+    std::string m_buffer;
+};
+
+#endif // PROFILEROVERLAY_H
@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <functional>
+#include "../render/InstrumentedRenderTarget.h"
 
 struct Button
 {
@@ -52,16 +53,16 @@ struct Button
         useSprite = true;
     }
 
-    void draw(sf::RenderWindow &window)
+    void draw(InstrumentedRenderTarget &target)
     {
         if (useSprite)
         {
-            window.draw(sprite);
+            target.draw(sprite);
         }
         else
         {
-            window.draw(shape);
-            window.draw(text);
+            target.draw(shape);
+            target.draw(text);
         }
     }
 